@@ -27,14 +27,17 @@ void APolyZone_Visualizer::SetupDynamicMaterial()
 {
 	if( IsValid(DynamicMeshComponent) )
 	{
-		FSoftObjectPath DefaultMaterialPath(TEXT("Material'/PolyZones_Plugin/PolyZoneDebugMaterial.PolyZoneDebugMaterial'"));
-		UMaterial* DefaultMaterial = Cast<UMaterial>(DefaultMaterialPath.ResolveObject()); // Try getting already loaded material
-		if( !IsValid(DefaultMaterial) )
+		// Create a dynamic version so we can recolor it, later rebuilds only update the color
+		if( !IsValid(DynamicMaterial) )
 		{
-			DefaultMaterial = CastChecked<UMaterial>(DefaultMaterialPath.TryLoad()); // If not loaded already, load it
+			FSoftObjectPath DefaultMaterialPath(TEXT("Material'/PolyZones_Plugin/PolyZoneDebugMaterial.PolyZoneDebugMaterial'"));
+			UMaterial* DefaultMaterial = Cast<UMaterial>(DefaultMaterialPath.ResolveObject()); // Try getting already loaded material
+			if( !IsValid(DefaultMaterial) )
+			{
+				DefaultMaterial = CastChecked<UMaterial>(DefaultMaterialPath.TryLoad()); // If not loaded already, load it
+			}
+			DynamicMaterial = UMaterialInstanceDynamic::Create(DefaultMaterial, this, FName("M_CreatedInstance"));
 		}
-		// Create a dynamic version so we can recolor it
-		DynamicMaterial = UMaterialInstanceDynamic::Create(DefaultMaterial, this, FName("M_CreatedInstance"));
 		DynamicMaterial->SetVectorParameterValue(FName(TEXT("Color")), FLinearColor(PolyColor));
 		DynamicMeshComponent->SetMaterial(0, DynamicMaterial);
 	}
@@ -57,7 +60,27 @@ void APolyZone_Visualizer::ExecuteRebuildGeneratedMeshIfPending()
 
 void APolyZone_Visualizer::RebuildVisualizer()
 {
-	RebuildMesh(DynamicMeshComponent->GetDynamicMesh());
+	UDynamicMesh* TargetMesh = DynamicMeshComponent->GetDynamicMesh();
+	if( IsValid(TargetMesh) )
+	{
+		TargetMesh->Reset(); // Append would stack the new walls on the old ones
+	}
+	RebuildMesh(TargetMesh);
+}
+
+void APolyZone_Visualizer::UpdateVisualizer(const TArray<FVector2D>& InPolygonVertices, float InPolyZoneHeight, FColor InPolyColor)
+{
+	const UDynamicMesh* CurrentMesh = DynamicMeshComponent->GetDynamicMesh();
+	const bool HasMesh = IsValid(CurrentMesh) && CurrentMesh->GetTriangleCount() > 0;
+	if( HasMesh && PolygonVertices == InPolygonVertices && PolyZoneHeight == InPolyZoneHeight && PolyColor == InPolyColor )
+	{
+		return; // Moving or rotating the zone doesn't change the local space walls
+	}
+
+	PolygonVertices = InPolygonVertices;
+	PolyZoneHeight = InPolyZoneHeight;
+	PolyColor = InPolyColor;
+	RebuildVisualizer();
 }
 
 void APolyZone_Visualizer::RebuildMesh(UDynamicMesh* TargetMesh)
@@ -16,6 +16,9 @@ public:
 
 	void RebuildVisualizer();
 
+	// Only re-extrudes when something changed, so the actor can be kept across zone rebuilds
+	void UpdateVisualizer(const TArray<FVector2D>& InPolygonVertices, float InPolyZoneHeight, FColor InPolyColor);
+
 protected:
 	virtual void ExecuteRebuildGeneratedMeshIfPending() override;
 	virtual void BeginPlay() override;
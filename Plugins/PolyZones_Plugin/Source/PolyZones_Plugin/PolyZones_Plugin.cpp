@@ -1,9 +1,39 @@
 // Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
 
 #include "PolyZones_Plugin.h"
+#include "PolyZone_Stats.h"
 
 #define LOCTEXT_NAMESPACE "FPolyZones_PluginModule"
 
+DEFINE_LOG_CATEGORY(LogPolyZones);
+
+DEFINE_STAT(STAT_PolyZone_Build);
+DEFINE_STAT(STAT_PolyZone_BuildPolygon);
+DEFINE_STAT(STAT_PolyZone_BuildShape);
+DEFINE_STAT(STAT_PolyZone_BuildQueryPath);
+DEFINE_STAT(STAT_PolyZone_BuildGrid);
+DEFINE_STAT(STAT_PolyZone_BuildBounds);
+DEFINE_STAT(STAT_PolyZone_BuildVisualizer);
+DEFINE_STAT(STAT_PolyZone_ActorTracking);
+DEFINE_STAT(STAT_PolyZone_PointQuery);
+DEFINE_STAT(STAT_PolyZone_EventDispatch);
+DEFINE_STAT(STAT_PolyZone_RandomPoints);
+DEFINE_STAT(STAT_PolyZone_ActiveZones);
+DEFINE_STAT(STAT_PolyZone_TrackedActors);
+DEFINE_STAT(STAT_PolyZone_ActorsInZones);
+DEFINE_STAT(STAT_PolyZone_Events);
+DEFINE_STAT(STAT_PolyZone_PointQueries);
+DEFINE_STAT(STAT_PolyZone_GridWithin);
+DEFINE_STAT(STAT_PolyZone_GridOutside);
+DEFINE_STAT(STAT_PolyZone_GridOnEdge);
+DEFINE_STAT(STAT_PolyZone_PolygonTests);
+DEFINE_STAT(STAT_PolyZone_QueryCacheHits);
+DEFINE_STAT(STAT_PolyZone_QueryCacheMisses);
+DEFINE_STAT(STAT_PolyZone_Shapes);
+DEFINE_STAT(STAT_PolyZone_ShapeMemory);
+
+CSV_DEFINE_CATEGORY(PolyZones, true);
+
 void FPolyZones_PluginModule::StartupModule()
 {
 	// This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
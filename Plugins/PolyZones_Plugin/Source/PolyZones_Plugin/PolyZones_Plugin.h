@@ -4,6 +4,8 @@
 
 #include "Modules/ModuleManager.h"
 
+DECLARE_LOG_CATEGORY_EXTERN(LogPolyZones, Log, All);
+
 class FPolyZones_PluginModule : public IModuleInterface
 {
 public:
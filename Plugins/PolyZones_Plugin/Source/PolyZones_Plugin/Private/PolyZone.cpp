@@ -1,17 +1,35 @@
 // Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
 
 #include "PolyZone.h"
+#include "PolyZones_Plugin.h"
+#include "PolyZone_Stats.h"
+#include "PolyZone_Subsystem.h"
+#include "PolyZone_Sampling.h"
 
 #if WITH_EDITORONLY_DATA
 #include "PolyZone_Visualizer.h"
+#include "Components/ChildActorComponent.h"
 #endif
 
 #include "Runtime/Launch/Resources/Version.h"
 #include "PolyZone_Interface.h"
 #include "Components/BillboardComponent.h"
 #include "Components/BoxComponent.h"
+#include "Components/LineBatchComponent.h"
 #include "DrawDebugHelpers.h"
 #include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Net/UnrealNetwork.h"
+
+// What the query cache knows about one location, each result is only valid with its Has flag
+namespace QueryCacheFlags
+{
+	constexpr uint8 HasFull = 1 << 0;
+	constexpr uint8 Full = 1 << 1;
+	constexpr uint8 HasSkipHeight = 1 << 2;
+	constexpr uint8 SkipHeight = 1 << 3;
+}
 
 // Sets default values
 APolyZone::APolyZone()
@@ -20,12 +38,6 @@ APolyZone::APolyZone()
 
 	OverlapTypes.Add(ECollisionChannel::ECC_Pawn);
 
-	// Grid defaults
-	CornerDirections.Add(FVector2D(-1.0f, -1.0f)); // BL
-	CornerDirections.Add(FVector2D(1.0f, -1.0f)); // TL
-	CornerDirections.Add(FVector2D(1.0f, 1.0f)); // TR
-	CornerDirections.Add(FVector2D(-1.0f, 1.0f)); // BR
-
 	// Initializations
 	USceneComponent* SceneComponent = CreateDefaultSubobject<USceneComponent>(TEXT("SceneComp"));
 	SetRootComponent(SceneComponent); // Set actor root before creating other components
@@ -34,8 +46,14 @@ APolyZone::APolyZone()
 	PolySpline = CreateDefaultSubobject<USplineComponent>("PolySpline");
 	PolySpline->SetupAttachment(RootComponent);
 
+	// Native, so it survives construction script reruns and is only reshaped by Construct_Bounds
+	UBoxComponent* BoxOverlap = CreateDefaultSubobject<UBoxComponent>("BoundsOverlap");
+	BoxOverlap->SetupAttachment(RootComponent);
+	BoxOverlap->SetCollisionEnabled(ECollisionEnabled::NoCollision); // Until Construct_Bounds sets it up
+	BoundsOverlap = BoxOverlap;
+
 	#if WITH_EDITORONLY_DATA // Editor only defaults
-	bRunConstructionScriptOnDrag = false; // Allow spline editing without the lag
+	bRunConstructionScriptOnDrag = true; // The grid and visualizer rebuild incrementally, so spline edits update live
 
 	PolyIcon = CreateEditorOnlyDefaultSubobject<UBillboardComponent>("PolyIcon");
 	if( PolyIcon )
@@ -43,12 +61,26 @@ APolyZone::APolyZone()
 		PolyIcon->SetRelativeLocation(FVector(0.0f, 0.0f, 50.0f));
 		PolyIcon->SetupAttachment(RootComponent);
 	}
+
+	EditorVisualizer = CreateEditorOnlyDefaultSubobject<UChildActorComponent>("EditorVisualizer");
+	if( EditorVisualizer )
+	{
+		EditorVisualizer->SetupAttachment(RootComponent); // Polygon is in local space, so the walls follow the zone
+		EditorVisualizer->SetChildActorClass(APolyZone_Visualizer::StaticClass());
+	}
 	#endif
 	SetCanBeDamaged(false);
+	ReplicatedMembers.Owner = this;
 }
 
 void APolyZone::OnConstruction(const FTransform& Transform)
 {
+	RootComponent->SetMobility(bMovableZone ? EComponentMobility::Movable : EComponentMobility::Static);
+	if( bReplicateMembership )
+	{
+		bReplicates = true; // Only ever forced on, subclasses and instances may replicate for their own reasons
+		bAlwaysRelevant = true;
+	}
 	Build_PolyZone();
 	PolyZoneConstructed(); // For some reason blueprints construction script has a race condition, so we call our own for now
 	Super::OnConstruction(Transform);
@@ -58,20 +90,52 @@ void APolyZone::OnConstruction(const FTransform& Transform)
 void APolyZone::BeginPlay()
 {
 	Super::BeginPlay();
+	INC_DWORD_STAT(STAT_PolyZone_ActiveZones);
+
+	if( bReplicateMembership && HasAuthority() && !GetIsReplicated() )
+	{
+		SetReplicates(true); // Spawned at runtime, make sure the net driver knows about us
+	}
+
+	// Streamed in while playing, the subsystem builds us within its frame budget
+	UPolyZone_Subsystem* ZoneSubsystem = UPolyZone_Subsystem::Get(this);
+	if( ZoneSubsystem && ZoneSubsystem->ShouldDeferBuild(this) )
+	{
+		ZoneSubsystem->QueueBuild(this);
+		return;
+	}
+	Activate_PolyZone();
+}
 
-	// Reconstruct needed data
-	Construct_Bounds();
+// Builds, registers and starts tracking, from BeginPlay or later from the subsystem's build queue
+void APolyZone::Activate_PolyZone()
+{
+	bBuildQueued = false;
+
+	// Reconstruct needed data (placed zones reuse their baked grid)
 	Build_PolyZone();
 	#if WITH_EDITORONLY_DATA
 	Construct_Visualizer();
 	#endif
 
-	// Initialize actor tracking
-	if( IsValid(BoundsOverlap) )
+	// Moving zones only need their transform refreshed, the shape is in local space
+	if( bMovableZone )
+	{
+		RootComponent->SetMobility(EComponentMobility::Movable);
+		RootComponent->TransformUpdated.AddUObject(this, &APolyZone::OnZoneTransformUpdated);
+	}
+
+	if( UPolyZone_Subsystem* ZoneSubsystem = UPolyZone_Subsystem::Get(this) )
+	{
+		ZoneSubsystem->RegisterZone(this);
+	}
+
+	// Initialize actor tracking (clients of replicated zones get their members from the server instead)
+	if( IsValid(BoundsOverlap) && !IsMembershipFromServer() )
 	{
 		// Bind Overlap Events
-		BoundsOverlap->OnComponentBeginOverlap.AddDynamic(this, &APolyZone::OnBeginBoundsOverlap);
-		BoundsOverlap->OnComponentEndOverlap.AddDynamic(this, &APolyZone::OnEndBoundsOverlap);
+		BoundsOverlap->OnComponentBeginOverlap.AddUniqueDynamic(this, &APolyZone::OnBeginBoundsOverlap);
+		BoundsOverlap->OnComponentEndOverlap.AddUniqueDynamic(this, &APolyZone::OnEndBoundsOverlap);
 
 		// Track pre-spawned actors
 		TArray<AActor*> StartingOverlaps;
@@ -89,7 +153,11 @@ void APolyZone::BeginPlay()
 
 void APolyZone::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
+	bBuildQueued = false;
 	SetActorTickEnabled(false);
+	RootComponent->TransformUpdated.RemoveAll(this);
+	Occupancy.Empty();
+	DEC_DWORD_STAT(STAT_PolyZone_ActiveZones);
 
 	TArray<TPair<AActor*, bool>> TrackedActorsArray;
 
@@ -111,9 +179,38 @@ void APolyZone::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		}
 	}
 
+	// Clients of replicated zones never tracked anything, exit whatever the server told us about
+	if( IsMembershipFromServer() )
+	{
+		TArray<AActor*> Members = ActorsInPolyZone; // Notifies change the array
+		for( AActor* Member : Members )
+		{
+			if( IsValid(Member) )
+			{
+				PolyZoneOverlapChange(Member, false);
+			}
+		}
+	}
+
+	if( UPolyZone_Subsystem* ZoneSubsystem = UPolyZone_Subsystem::Get(this) )
+	{
+		ZoneSubsystem->UnregisterZone(this);
+	}
+
 	Super::EndPlay(EndPlayReason);
 }
 
+void APolyZone::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME(APolyZone, ReplicatedMembers);
+}
+
+bool APolyZone::IsMembershipFromServer() const
+{
+	return bReplicateMembership && GetNetMode() == NM_Client;
+}
+
 void APolyZone::K2_DestroyActor()
 {
 	// Delays destroy by 1 tick, if called via blueprint
@@ -132,12 +229,16 @@ void APolyZone::Tick(float DeltaTime)
 	}
 
 	if( ActorTracking ) DoActorTracking();
-	if( bDebugGrid ) DrawDebugGrid();
+	DrawDebugGrid(); // Also clears the cached lines once bDebugGrid is turned off
 }
 
 // Rebuilds the PolyZone (can be run during runtime)
 void APolyZone::Build_PolyZone()
 {
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_Build);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::Build_PolyZone);
+	CSV_SCOPED_TIMING_STAT(PolyZones, Build);
+
 	if( PolySpline->GetNumberOfSplinePoints() < 3 ) // A polygon must have at least 3 points to be valid
 	{
 		// Create a default polygon
@@ -149,29 +250,63 @@ void APolyZone::Build_PolyZone()
 	}
 	if( PolySpline->GetNumberOfSplinePoints() >= 3 ) // We check again because sometimes the default is overridden
 	{
-		Construct_Polygon();
+		UpdateZoneFrame();
+
+		TArray<FVector2D> SourcePolygon;
+		Construct_Polygon(SourcePolygon);
+		Construct_Shape(SourcePolygon);
+		Construct_HeightField();
 		Construct_Bounds();
-		Construct_SetupGrid();
 		Construct_Visualizer();
+		Construct_Occupancy();
+
+		if( UPolyZone_Subsystem* ZoneSubsystem = UPolyZone_Subsystem::Get(this) )
+		{
+			ZoneSubsystem->RefreshZone(this); // Rebuilt while playing, nothing happens before the zone registers
+		}
 	}
 }
 
-void APolyZone::Construct_Polygon()
+void APolyZone::Construct_Polygon(TArray<FVector2D>& OutPolygon)
 {
-	Polygon.Empty(); // Can rebuild at runtime
-	Polygon2D.Empty();
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_BuildPolygon);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::Construct_Polygon);
+
+	OutPolygon.Reset(); // Can rebuild at runtime
 
-	// Make spline flat and ensure all points are linear
+	// Make spline flat and ensure all points are linear (unless we are keeping the curves, or the heights for the floor)
 	int LastSplineIndex = PolySpline->GetNumberOfSplinePoints() - 1;
 	double ActorHeight = GetActorLocation().Z;
+	const bool KeepSplineHeight = HeightMode == POLYZONE_HEIGHT_MODE::SplineHeight;
 	for( int i = 0; i <= LastSplineIndex; i++ )
 	{
-		PolySpline->SetSplinePointType(i, ESplinePointType::Linear, false);
-		FVector SplinePoint = PolySpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
-		SplinePoint.Z = ActorHeight;
-		PolySpline->SetLocationAtSplinePoint(i, SplinePoint, ESplineCoordinateSpace::World, false);
-		Polygon.Add(SplinePoint);
-		Polygon2D.Add(FVector2D(SplinePoint.X, SplinePoint.Y));
+		if( bPreserveCurves )
+		{
+			if( KeepSplineHeight )
+			{
+				continue; // The curve may climb with the points, the polygon below is flattened either way
+			}
+
+			// Flatten the tangents too, otherwise the curve leaves the zone plane between points
+			FVector ArriveTangent = PolySpline->GetArriveTangentAtSplinePoint(i, ESplineCoordinateSpace::World);
+			FVector LeaveTangent = PolySpline->GetLeaveTangentAtSplinePoint(i, ESplineCoordinateSpace::World);
+			if( !FMath::IsNearlyZero(ArriveTangent.Z) || !FMath::IsNearlyZero(LeaveTangent.Z) ) // Setting tangents switches the point to custom tangents
+			{
+				ArriveTangent.Z = 0.0f;
+				LeaveTangent.Z = 0.0f;
+				PolySpline->SetTangentsAtSplinePoint(i, ArriveTangent, LeaveTangent, ESplineCoordinateSpace::World, false);
+			}
+		}
+		else
+		{
+			PolySpline->SetSplinePointType(i, ESplinePointType::Linear, false);
+		}
+		if( !KeepSplineHeight )
+		{
+			FVector SplinePoint = PolySpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
+			SplinePoint.Z = ActorHeight;
+			PolySpline->SetLocationAtSplinePoint(i, SplinePoint, ESplineCoordinateSpace::World, false);
+		}
 	}
 
 	PolySpline->SetUnselectedSplineSegmentColor(FLinearColor(0, 1, 0)); // Make spline green
@@ -179,34 +314,119 @@ void APolyZone::Construct_Polygon()
 	PolySpline->bInputSplinePointsToConstructionScript = true;
 	PolySpline->UpdateSpline(); // Call after making all our edits
 
-	// Save calculated bounds to save cpu cycles in PolyZone test
-	Bounds_MinX = Polygon[0].X;
-	Bounds_MaxX = Polygon[0].X;
-	Bounds_MinY = Polygon[0].Y;
-	Bounds_MaxY = Polygon[0].Y;
-	for( int i = 1; i < LastSplineIndex + 1; i++ )
+	// Build the local space polygon, curved segments are tessellated once here so every query only deals with straight edges
+	const int32 MaxDepth = FMath::FloorLog2(FMath::Clamp(MaxVerticesPerSegment, 1, 255) + 1); // Depth d adds at most 2^d - 1 vertices
+	for( int i = 0; i <= LastSplineIndex; i++ )
 	{
-		FVector q = Polygon[i];
-		Bounds_MinX = FMath::Min(q.X, Bounds_MinX);
-		Bounds_MaxX = FMath::Max(q.X, Bounds_MaxX);
-		Bounds_MinY = FMath::Min(q.Y, Bounds_MinY);
-		Bounds_MaxY = FMath::Max(q.Y, Bounds_MaxY);
+		FVector SplinePoint = PolySpline->GetLocationAtSplinePoint(i, ESplineCoordinateSpace::World);
+		SplinePoint.Z = ActorHeight;
+		OutPolygon.Add(ZoneFrame.ToLocal(SplinePoint));
+
+		if( bPreserveCurves && MaxDepth > 0 )
+		{
+			FVector NextSplinePoint = PolySpline->GetLocationAtSplinePoint((i + 1) % (LastSplineIndex + 1), ESplineCoordinateSpace::World);
+			NextSplinePoint.Z = ActorHeight;
+			Construct_TessellateSegment(i, SplinePoint, i + 1, NextSplinePoint, MaxDepth, OutPolygon);
+		}
+	}
+}
+
+// Adaptive subdivision of a single spline segment, only adds points where the curve strays further than CurveTolerance from the chord
+void APolyZone::Construct_TessellateSegment(float StartKey, const FVector& StartPoint, float EndKey, const FVector& EndPoint, int32 Depth, TArray<FVector2D>& OutPolygon)
+{
+	if( Depth <= 0 )
+	{
+		return;
+	}
+
+	const double ActorHeight = GetActorLocation().Z;
+	const float MidKey = (StartKey + EndKey) * 0.5f;
+	FVector MidPoint = PolySpline->GetLocationAtSplineInputKey(MidKey, ESplineCoordinateSpace::World);
+	MidPoint.Z = ActorHeight;
+
+	// Sample the quarter points as well, the midpoint of an S-curve can sit right on the chord
+	bool WithinTolerance = FMath::PointDistToSegment(MidPoint, StartPoint, EndPoint) <= CurveTolerance;
+	if( WithinTolerance )
+	{
+		for( const float Alpha : { 0.25f, 0.75f } )
+		{
+			FVector QuarterPoint = PolySpline->GetLocationAtSplineInputKey(FMath::Lerp(StartKey, EndKey, Alpha), ESplineCoordinateSpace::World);
+			QuarterPoint.Z = ActorHeight;
+			if( FMath::PointDistToSegment(QuarterPoint, StartPoint, EndPoint) > CurveTolerance )
+			{
+				WithinTolerance = false;
+				break;
+			}
+		}
+	}
+
+	if( !WithinTolerance )
+	{
+		Construct_TessellateSegment(StartKey, StartPoint, MidKey, MidPoint, Depth - 1, OutPolygon);
+		OutPolygon.Add(ZoneFrame.ToLocal(MidPoint));
+		Construct_TessellateSegment(MidKey, MidPoint, EndKey, EndPoint, Depth - 1, OutPolygon);
+	}
+}
+
+// Simplification, query path and grid all live in the shared shape, identical zones only build them once
+void APolyZone::Construct_Shape(const TArray<FVector2D>& SourcePolygon)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_BuildShape);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::Construct_Shape);
+
+	const FPolyZone_ShapeSettings Settings = GetShapeSettings();
+	// Placed zones load with the cells they were saved with, as long as the polygon hasn't changed since
+	const uint32 SourceHash = FPolyZone_Shape::GetSourceHash(SourcePolygon, Settings);
+	Shape = FPolyZone_Shape::FindOrBuild(SourcePolygon, Settings, Shape.Get(), BakedGrid.Find(SourceHash, SourcePolygon)); // The old shape lets a spline edit only retest the cells it touched
+
+	if( GetWorld() && !GetWorld()->IsGameWorld() )
+	{
+		BakedGrid.Bake(SourceHash, SourcePolygon, Shape->GridData);
+	}
+
+	SourceVertexCount = Shape->SourceVertexCount;
+	PolygonVertexCount = Shape->Polygon.Num();
+	QueryPath = Shape->QueryPath;
+	ConvexPieceCount = Shape->ConvexPieces.Num();
+	UpdateZoneFrame();
+
+	if( VertexBudget > 0 && PolygonVertexCount > VertexBudget )
+	{
+		UE_LOG(LogPolyZones, Warning, TEXT("%s uses %d polygon vertices, which is over its budget of %d"), *GetName(), PolygonVertexCount, VertexBudget);
 	}
 }
 
 void APolyZone::Construct_Bounds()
 {
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_BuildBounds);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::Construct_Bounds);
+
+	if( !Shape.IsValid() )
+	{
+		return; // Nothing to bound yet
+	}
+
 	// TODO (Oct22/2022) : Calculate smallest rectangular bounds for overlap
-	PolyBounds = PolySpline->CalcBounds(PolySpline->GetComponentTransform());
-	UBoxComponent* NewBoundsOverlap = NewObject<UBoxComponent>(this);
-	NewBoundsOverlap->CreationMethod = EComponentCreationMethod::UserConstructionScript;
-	if( NewBoundsOverlap )
+	// The box is built from the local bounds and attached to the root, so it follows the zone when it moves or rotates
+	const FVector2D LocalCenter = (Shape->BoundsMin + Shape->BoundsMax) * 0.5f;
+	const FVector2D LocalExtent = (Shape->BoundsMax - Shape->BoundsMin) * 0.5f;
+	// Fitted to the baked floors, so hilly zones don't need one huge slab
+	const FFloatInterval FloorRange = HeightField.IsValid() ? HeightField->GetTotalRange() : FFloatInterval(0.0f, 0.0f);
+	const float LocalHalfHeight = (FloorRange.Size() + ZoneHeight) * 0.5f * ZoneFrame.InvScale; // ZoneHeight is in world units
+	const float LocalCenterZ = FloorRange.Min * ZoneFrame.InvScale + LocalHalfHeight;
+
+	// Reshape the existing box, only zones saved before it was a default component need a new one
+	UBoxComponent* NewBoundsOverlap = Cast<UBoxComponent>(BoundsOverlap);
+	if( !IsValid(NewBoundsOverlap) )
 	{
-		// Create
-		FVector OverlapExtent = FVector(PolyBounds.BoxExtent.X, PolyBounds.BoxExtent.Y, ZoneHeight * 0.5f);
-		NewBoundsOverlap->SetAbsolute(true, true, true); // Ignore relative transform
+		NewBoundsOverlap = NewObject<UBoxComponent>(this);
+		NewBoundsOverlap->CreationMethod = EComponentCreationMethod::UserConstructionScript;
 		NewBoundsOverlap->RegisterComponent();
 		NewBoundsOverlap->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
+	}
+	if( NewBoundsOverlap )
+	{
+		FVector OverlapExtent = FVector(LocalExtent.X, LocalExtent.Y, LocalHalfHeight);
 
 		#if WITH_EDITORONLY_DATA
 		// Setup Visualization
@@ -217,7 +437,7 @@ void APolyZone::Construct_Bounds()
 
 		// Setup Shape
 		NewBoundsOverlap->SetBoxExtent(OverlapExtent);
-		NewBoundsOverlap->SetWorldLocation(PolyBounds.Origin + FVector(0, 0, ZoneHeight * 0.5f));
+		NewBoundsOverlap->SetRelativeLocation(FVector(LocalCenter.X, LocalCenter.Y, LocalCenterZ));
 
 		// Setup Collision
 		NewBoundsOverlap->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
@@ -231,112 +451,293 @@ void APolyZone::Construct_Bounds()
 	BoundsOverlap = NewBoundsOverlap;
 }
 
-void APolyZone::Construct_SetupGrid()
+void APolyZone::Construct_Visualizer()
 {
-	GridData.Empty(); // Can rebuild at runtime
+	#if WITH_EDITORONLY_DATA
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_BuildVisualizer);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::Construct_Visualizer);
 
-	int32 NumPoints = PolySpline->GetNumberOfSplinePoints();
-	UsesGrid = (NumPoints >= 6);
-	if( UsesGrid )
+	if( !IsValid(EditorVisualizer) )
 	{
-		// Calculate a performant cell size
-		float DesiredCellCount = FMath::Min(40.0f, 2.0f * NumPoints);
-		float DistanceToCover = FMath::Max(PolyBounds.BoxExtent.X * 2.0f, PolyBounds.BoxExtent.Y * 2.0f);
-		CellSize = DistanceToCover / DesiredCellCount;
+		return;
+	}
 
-		FVector2D BoundsBottomLeft;
-		BoundsBottomLeft.X = PolyBounds.Origin.X - PolyBounds.BoxExtent.X;
-		BoundsBottomLeft.Y = PolyBounds.Origin.Y - PolyBounds.BoxExtent.Y;
-		FVector2D BoundsTopRight;
-		BoundsTopRight.X = PolyBounds.Origin.X + PolyBounds.BoxExtent.X;
-		BoundsTopRight.Y = PolyBounds.Origin.Y + PolyBounds.BoxExtent.Y;
+	if( !ShowVisualization )
+	{
+		EditorVisualizer->DestroyChildActor();
+		return;
+	}
+
+	// The visualizer actor is kept between rebuilds, only its mesh changes
+	if( !IsValid(EditorVisualizer->GetChildActor()) )
+	{
+		EditorVisualizer->CreateChildActor();
+	}
+	APolyZone_Visualizer* Viz = Cast<APolyZone_Visualizer>(EditorVisualizer->GetChildActor());
+	if( IsValid(Viz) && Shape.IsValid() )
+	{
+		Viz->SetActorHiddenInGame(HideInPlay);
+		Viz->UpdateVisualizer(Shape->Polygon, ZoneHeight * ZoneFrame.InvScale, ZoneColor);
+	}
+	#endif
+}
+
+// The layer is sized to the grid, so a rebuild at runtime starts counting again
+void APolyZone::Construct_Occupancy()
+{
+	Occupancy.Empty();
+	if( !bOccupancyLayer || !Shape.IsValid() || !GetWorld() || !GetWorld()->IsGameWorld() )
+	{
+		return;
+	}
 
-		// Find the cell (world grid) for the bottom left bounds, and make it our local grid origin
-		const double NewOriginX = FMath::FloorToDouble(BoundsBottomLeft.X / CellSize) * CellSize;
-		const double NewOriginY = FMath::FloorToDouble(BoundsBottomLeft.Y / CellSize) * CellSize;
-		GridOrigin = FVector(NewOriginX, NewOriginY, GetActorLocation().Z);
+	if( !Shape->UsesGrid )
+	{
+		UE_LOG(LogPolyZones, Warning, TEXT("%s has bOccupancyLayer but no grid (fewer than 6 vertices), occupancy is disabled"), *GetName());
+		return;
+	}
+	Occupancy.Reset(Shape->GridCellsX, Shape->GridCellsY, OccupancyHalfLife);
+}
 
-		float DistanceX = BoundsTopRight.X - GridOrigin.X;
-		float DistanceY = BoundsTopRight.Y - GridOrigin.Y;
+// Floors are relative to the actor, so a moving zone carries its baked floors along
+void APolyZone::Construct_HeightField()
+{
+	HeightField.Reset();
+	if( HeightMode == POLYZONE_HEIGHT_MODE::Flat || !Shape.IsValid() )
+	{
+		return;
+	}
 
-		// Find how many cells we will need to cover the polygon
-		GridCellsX = FMath::CeilToInt(DistanceX / CellSize);
-		GridCellsY = FMath::CeilToInt(DistanceY / CellSize);
+	if( !Shape->UsesGrid )
+	{
+		UE_LOG(LogPolyZones, Warning, TEXT("%s has a HeightMode but no grid (fewer than 6 vertices), the zone stays flat"), *GetName());
+		return;
+	}
 
-		const int32 TotalCells = GridCellsX * GridCellsY;
-		GridData.Init(POLYZONE_CELL_FLAGS::Outside, TotalCells);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::Construct_HeightField);
+	TSharedRef<FPolyZone_HeightField, ESPMode::ThreadSafe> NewHeightField = MakeShared<FPolyZone_HeightField, ESPMode::ThreadSafe>();
+	const double OriginZ = ZoneFrame.Origin.Z;
 
-		// Populate grid data
-		for( int32 GridX = 0; GridX < GridCellsX; GridX++ )
+	if( HeightMode == POLYZONE_HEIGHT_MODE::SplineHeight )
+	{
+		// Sampled along the whole spline, so long edges weigh as much as their end points
+		const float SplineLength = PolySpline->GetSplineLength();
+		const int32 NumSamples = FMath::Clamp(FMath::CeilToInt32(SplineLength / FMath::Max(CellSize * 2.0, 1.0)), PolySpline->GetNumberOfSplinePoints(), 256);
+		TArray<FVector> HeightSamples;
+		HeightSamples.Reserve(NumSamples);
+		for( int32 i = 0; i < NumSamples; i++ )
 		{
-			for( int32 GridY = 0; GridY < GridCellsY; GridY++ )
+			const FVector SplineLocation = PolySpline->GetLocationAtDistanceAlongSpline(SplineLength * i / NumSamples, ESplineCoordinateSpace::World);
+			const FVector2D LocalLocation = ZoneFrame.ToLocal(SplineLocation);
+			HeightSamples.Emplace(LocalLocation.X, LocalLocation.Y, SplineLocation.Z - OriginZ);
+		}
+		NewHeightField->Build(*Shape, [this, &HeightSamples](const FVector2D& LocalPoint) { return SampleSplineFloor(LocalPoint, HeightSamples); });
+	}
+	else
+	{
+		UWorld* World = GetWorld();
+		const FCollisionQueryParams TraceParams(SCENE_QUERY_STAT(PolyZoneHeightTrace), false, this);
+		NewHeightField->Build(*Shape, [this, World, OriginZ, &TraceParams](const FVector2D& LocalPoint)
+		{
+			FHitResult Hit;
+			const FVector TraceStart = ZoneFrame.ToWorld(LocalPoint, OriginZ + HeightTraceDistance);
+			const FVector TraceEnd = ZoneFrame.ToWorld(LocalPoint, OriginZ - HeightTraceDistance);
+			if( World && World->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, HeightTraceChannel, TraceParams) )
 			{
-				FPolyZone_GridCell NewCell = FPolyZone_GridCell(GridX, GridY);
-				POLYZONE_CELL_FLAGS FlagForNewCell = TestCellAgainstPolygon(NewCell);
-				const int32 CellIndex = GetGridCellIndex(NewCell);
-				if( CellIndex != INDEX_NONE )
-				{
-					GridData[CellIndex] = FlagForNewCell;
-				}
+				return Hit.ImpactPoint.Z - OriginZ;
 			}
-		}
+			return 0.0; // Nothing below, keep the actor's height
+		});
 	}
+
+	HeightField = NewHeightField;
+	InvalidateQuerySnapshot();
 }
 
-void APolyZone::Construct_Visualizer()
+// Inverse distance weighted, so the floor matches the spline on the edges and blends smoothly across the inside
+double APolyZone::SampleSplineFloor(const FVector2D& LocalPoint, const TArray<FVector>& HeightSamples) const
 {
-	#if WITH_EDITORONLY_DATA
-	if( ShowVisualization )
+	double WeightedHeight = 0.0;
+	double TotalWeight = 0.0;
+	for( const FVector& Sample : HeightSamples )
 	{
-		UChildActorComponent* NewVisualizer = NewObject<UChildActorComponent>(this);
-		if( NewVisualizer )
+		const double DistSquared = FVector2D::DistSquared(LocalPoint, FVector2D(Sample.X, Sample.Y));
+		if( DistSquared < 1.0 )
 		{
-			NewVisualizer->CreationMethod = EComponentCreationMethod::UserConstructionScript;
-			NewVisualizer->RegisterComponent();
-			NewVisualizer->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
-			NewVisualizer->SetChildActorClass(APolyZone_Visualizer::StaticClass());
+			return Sample.Z; // On the sample, the weight would blow up
 		}
-		EditorVisualizer = NewVisualizer;
+		WeightedHeight += Sample.Z / DistSquared;
+		TotalWeight += 1.0 / DistSquared;
+	}
+	return TotalWeight > 0.0 ? WeightedHeight / TotalWeight : 0.0;
+}
 
-		if( IsValid(EditorVisualizer) )
-		{
-			EditorVisualizer->SetWorldTransform(FTransform(FVector(0, 0, GetActorLocation().Z))); // Move XY to world origin
-			EditorVisualizer->CreateChildActor();
-			AActor* VizActor = EditorVisualizer->GetChildActor();
-			APolyZone_Visualizer* Viz = Cast<APolyZone_Visualizer>(VizActor);
-			if( IsValid(Viz) )
-			{
-				Viz->SetActorHiddenInGame(HideInPlay);
-				Viz->PolygonVertices = Polygon2D;
-				Viz->PolyZoneHeight = ZoneHeight;
-				Viz->PolyColor = ZoneColor;
-
-				if( GetWorld() && GetWorld()->IsGameWorld() )
-				{
-					Viz->RebuildVisualizer(); // We have to manually trigger the build, or it will not show in play
-				}
-			}
-		}
+void APolyZone::OnZoneTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport)
+{
+	UpdateZoneFrame();
+	if( UPolyZone_Subsystem* ZoneSubsystem = UPolyZone_Subsystem::Get(this) )
+	{
+		ZoneSubsystem->RefreshZone(this); // World polygon, bounds and neighbours follow the zone
 	}
-	#endif
 }
 
-TArray<AActor*> APolyZone::GetAllActorsWithinPolyZone()
+void APolyZone::UpdateZoneFrame()
 {
-	if( !ActorTracking )
+	ZoneFrame = FPolyZone_Frame::FromTransform(GetActorTransform());
+	InvalidateQuerySnapshot(); // Every shape change goes through here too
+	DebugGridDirty = true;
+	if( Shape.IsValid() )
 	{
-		DoActorTracking(); //If actor tracking is disabled, call it once so we have our list of actors
+		// Publish the grid in world space for blueprints
+		CellSize = Shape->CellSize * ZoneFrame.Scale;
+		GridOrigin = ZoneFrame.ToWorld(Shape->GridOrigin, ZoneFrame.Origin.Z);
 	}
-	return ActorsInPolyZone;
 }
 
-void APolyZone::GetAllActorsOfClassWithinPolyZone(TSubclassOf<AActor> Class, TArray<AActor*>& Actors)
+FPolyZone_ShapeSettings APolyZone::GetShapeSettings() const
 {
-	if( !ActorTracking )
+	FPolyZone_ShapeSettings Settings;
+	Settings.SimplifyMode = SimplifyMode;
+	Settings.SimplifyTolerance = SimplifyTolerance;
+	Settings.bDecomposeConcave = bDecomposeConcave;
+	Settings.MaxConvexPieces = MaxConvexPieces;
+	Settings.bRobustPredicates = bRobustPredicates;
+	return Settings;
+}
+
+FPolyZone_QuerySnapshotPtr APolyZone::GetQuerySnapshot()
+{
+	check(IsInGameThread());
+	if( !Shape.IsValid() )
 	{
-		DoActorTracking(); //If actor tracking is disabled, call it once so we have our list of actors
+		return nullptr;
 	}
 
+	if( QuerySnapshot.IsValid() && QuerySnapshot->GetZoneHeight() != ZoneHeight )
+	{
+		InvalidateQuerySnapshot(); // Written directly from C++, Blueprint and the editor go through SetZoneHeight and PostEditChangeProperty
+	}
+	if( !QuerySnapshot.IsValid() )
+	{
+		QuerySnapshot = MakeShared<FPolyZone_QuerySnapshot, ESPMode::ThreadSafe>(Shape.ToSharedRef(), HeightField, ZoneFrame, ZoneHeight, QueryVersion);
+	}
+	return QuerySnapshot;
+}
+
+void APolyZone::SetZoneHeight(float NewZoneHeight)
+{
+	if( ZoneHeight != NewZoneHeight )
+	{
+		ZoneHeight = NewZoneHeight;
+		Construct_Bounds(); // Reshapes the overlap box, so tracking sees actors in the new height too
+		InvalidateQuerySnapshot();
+	}
+}
+
+#if WITH_EDITOR
+void APolyZone::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	if( PropertyChangedEvent.GetPropertyName() == GET_MEMBER_NAME_CHECKED(APolyZone, ZoneHeight) )
+	{
+		InvalidateQuerySnapshot();
+	}
+}
+#endif
+
+void APolyZone::InvalidateQuerySnapshot()
+{
+	QueryVersion->fetch_add(1, std::memory_order_release);
+	QuerySnapshot.Reset();
+	QueryCache.Reset(); // Same triggers, a rebuild, move or height change
+}
+
+// If actor tracking is disabled, run it once so we have our list of actors (once a frame when queries are cached)
+void APolyZone::RefreshActorsInPolyZone()
+{
+	if( !ActorTracking && !(bCacheQueries && TrackingFrame == GFrameCounter) )
+	{
+		DoActorTracking();
+	}
+}
+
+// Drops the results of earlier frames, false when the cache shouldn't be used at all
+bool APolyZone::PrepareQueryCache()
+{
+	if( !bCacheQueries || !IsInGameThread() )
+	{
+		return false;
+	}
+	if( QueryCacheFrame != GFrameCounter || QueryCacheZoneHeight != ZoneHeight )
+	{
+		QueryCache.Reset();
+		QueryCacheFrame = GFrameCounter;
+		QueryCacheZoneHeight = ZoneHeight;
+	}
+	return true;
+}
+
+bool APolyZone::FindCachedQuery(const FVector& Location, bool SkipHeight, bool& OutResult)
+{
+	if( !PrepareQueryCache() )
+	{
+		return false;
+	}
+
+	const uint8* Flags = QueryCache.Find(Location);
+	if( Flags && (*Flags & (SkipHeight ? QueryCacheFlags::HasSkipHeight : QueryCacheFlags::HasFull)) )
+	{
+		OutResult = (*Flags & (SkipHeight ? QueryCacheFlags::SkipHeight : QueryCacheFlags::Full)) != 0;
+		QueryCacheHits++;
+		INC_DWORD_STAT(STAT_PolyZone_QueryCacheHits);
+		return true;
+	}
+
+	QueryCacheMisses++;
+	INC_DWORD_STAT(STAT_PolyZone_QueryCacheMisses);
+	return false;
+}
+
+void APolyZone::AddCachedQuery(const FVector& Location, bool SkipHeight, bool Result)
+{
+	if( !PrepareQueryCache() )
+	{
+		return;
+	}
+
+	uint8& Flags = QueryCache.FindOrAdd(Location);
+	if( SkipHeight )
+	{
+		Flags = static_cast<uint8>((Flags & ~QueryCacheFlags::SkipHeight) | QueryCacheFlags::HasSkipHeight | (Result ? QueryCacheFlags::SkipHeight : 0));
+	}
+	else
+	{
+		Flags = static_cast<uint8>((Flags & ~QueryCacheFlags::Full) | QueryCacheFlags::HasFull | (Result ? QueryCacheFlags::Full : 0));
+	}
+}
+
+float APolyZone::GetQueryCacheHitRate(bool ResetCounts)
+{
+	const uint32 NumQueries = QueryCacheHits + QueryCacheMisses;
+	const float HitRate = NumQueries > 0 ? static_cast<float>(QueryCacheHits) / NumQueries : 0.0f;
+	if( ResetCounts )
+	{
+		QueryCacheHits = 0;
+		QueryCacheMisses = 0;
+	}
+	return HitRate;
+}
+
+TArray<AActor*> APolyZone::GetAllActorsWithinPolyZone()
+{
+	RefreshActorsInPolyZone();
+	return ActorsInPolyZone;
+}
+
+void APolyZone::GetAllActorsOfClassWithinPolyZone(TSubclassOf<AActor> Class, TArray<AActor*>& Actors)
+{
+	RefreshActorsInPolyZone();
+
 	if( Class )
 	{
 		for( AActor* Actor : ActorsInPolyZone )
@@ -357,35 +758,74 @@ bool APolyZone::IsActorWithinPolyZone(AActor* Actor, bool SkipHeight)
 
 bool APolyZone::IsPointWithinPolyZone(FVector TestPoint, bool SkipHeight)
 {
-	// Height Check
-	if( !SkipHeight && !FMath::IsWithinInclusive(TestPoint.Z, GridOrigin.Z, GridOrigin.Z + ZoneHeight) )
+	INC_DWORD_STAT(STAT_PolyZone_PointQueries); // No cycle counter or trace scope, timing a single point costs more than the query
+
+	if( !Shape.IsValid() )
 	{
 		return false;
 	}
 
-	// 2D Bounds Check
-	if( TestPoint.X < Bounds_MinX || TestPoint.X > Bounds_MaxX || TestPoint.Y < Bounds_MinY || TestPoint.Y > Bounds_MaxY )
+	bool IsWithin = false;
+	if( FindCachedQuery(TestPoint, SkipHeight, IsWithin) )
 	{
-		return false;
+		return IsWithin;
+	}
+
+	// Height Check, then the shape
+	const FVector2D LocalPoint = ZoneFrame.ToLocal(TestPoint);
+	IsWithin = (SkipHeight || FPolyZone_HeightField::IsWithinZoneHeight(HeightField.Get(), LocalPoint, TestPoint.Z - ZoneFrame.Origin.Z, ZoneHeight)) &&
+		Shape->IsPointWithinShape(LocalPoint);
+
+	AddCachedQuery(TestPoint, SkipHeight, IsWithin);
+	return IsWithin;
+}
+
+TArray<bool> APolyZone::ArePointsWithinPolyZone(const TArray<FVector>& TestPoints, bool SkipHeight)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_PointQuery);
+	INC_DWORD_STAT_BY(STAT_PolyZone_PointQueries, TestPoints.Num());
+
+	TArray<bool> Results;
+	if( !Shape.IsValid() )
+	{
+		Results.Init(false, TestPoints.Num());
+		return Results;
 	}
 
-	// Grid check
-	if( UsesGrid )
+	TArray<FVector2D> LocalPoints;
+	LocalPoints.SetNumUninitialized(TestPoints.Num());
+	for( int32 i = 0; i < TestPoints.Num(); ++i )
 	{
-		POLYZONE_CELL_FLAGS CellFlag = GetFlagAtLocation(TestPoint);
-		if( CellFlag == POLYZONE_CELL_FLAGS::Outside ) return false;
-		if( CellFlag == POLYZONE_CELL_FLAGS::Within ) return true;
+		LocalPoints[i] = ZoneFrame.ToLocal(TestPoints[i]);
 	}
 
-	return IsPointWithinPolygon(FVector2D(TestPoint.X, TestPoint.Y));
+	Results.SetNumUninitialized(TestPoints.Num());
+	Shape->ArePointsWithinShape(LocalPoints, Results);
+
+	if( !SkipHeight )
+	{
+		for( int32 i = 0; i < TestPoints.Num(); ++i )
+		{
+			Results[i] = Results[i] && FPolyZone_HeightField::IsWithinZoneHeight(HeightField.Get(), LocalPoints[i], TestPoints[i].Z - ZoneFrame.Origin.Z, ZoneHeight);
+		}
+	}
+	return Results;
 }
 
 TArray<FVector> APolyZone::GetRandomPointsInPolyZone(int NumPoints, bool RandomHeight)
 {
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_RandomPoints);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::GetRandomPointsInPolyZone);
+
 	TArray<FVector> RandomPoints;
+	if( !Shape.IsValid() )
+	{
+		return RandomPoints;
+	}
 
-	FVector MinBounds = PolyBounds.Origin - PolyBounds.BoxExtent;
-	FVector MaxBounds = PolyBounds.Origin + PolyBounds.BoxExtent;
+	// Sample in local space, the local bounds are tighter than the world bounds of a rotated zone
+	const FVector2D MinBounds = Shape->BoundsMin;
+	const FVector2D MaxBounds = Shape->BoundsMax;
 
 	int Failures = 0;
 	int MaxFailures = FMath::Max(100.0f, NumPoints * 4);
@@ -394,14 +834,16 @@ TArray<FVector> APolyZone::GetRandomPointsInPolyZone(int NumPoints, bool RandomH
 	{
 		float RandomX = FMath::FRandRange(MinBounds.X, MaxBounds.X);
 		float RandomY = FMath::FRandRange(MinBounds.Y, MaxBounds.Y);
-		float HeightToAdd = RandomHeight ? FMath::FRandRange(0.0f, ZoneHeight) : 0.0f;
-		float RandomZ = GetActorLocation().Z + HeightToAdd;
 
-		FVector RandomPoint(RandomX, RandomY, RandomZ);
+		const FVector2D RandomPoint(RandomX, RandomY);
 
-		if( IsPointWithinPolygon(FVector2D(RandomX, RandomY)) )
+		if( Shape->IsPointWithinPolygon(RandomPoint) )
 		{
-			RandomPoints.Add(RandomPoint);
+			// Between the cell's lowest floor and its ceiling
+			const FFloatInterval FloorRange = HeightField.IsValid() ? HeightField->GetFloorRange(RandomPoint) : FFloatInterval(0.0f, 0.0f);
+			float HeightToAdd = RandomHeight ? FMath::FRandRange(FloorRange.Min, FloorRange.Max + ZoneHeight) : FloorRange.Min;
+			float RandomZ = ZoneFrame.Origin.Z + HeightToAdd;
+			RandomPoints.Add(ZoneFrame.ToWorld(RandomPoint, RandomZ));
 		}
 		else
 		{
@@ -412,233 +854,340 @@ TArray<FVector> APolyZone::GetRandomPointsInPolyZone(int NumPoints, bool RandomH
 	return RandomPoints;
 }
 
-TArray<FVector> APolyZone::GetRandomPointsAlongPolyZoneEdges(int NumPoints, bool RandomHeight)
+TArray<FVector> APolyZone::GetPoissonPointsInPolyZone(float MinSpacing, int MaxPoints, bool RandomHeight)
 {
-	TArray<FVector> RandomPoints;
-	if( IsValid(PolySpline) )
-	{
-		float SplineLength = PolySpline->GetSplineLength();
+	FRandomStream Stream(FMath::Rand());
+	return GetPoissonPointsInPolyZoneFromStream(Stream, MinSpacing, MaxPoints, RandomHeight);
+}
 
-		for( int i = 0; i < NumPoints; ++i )
-		{
-			float HeightToAdd = RandomHeight ? FMath::FRandRange(0.0f, ZoneHeight) : 0.0f;
-			float RandomDistance = FMath::FRandRange(0.0f, SplineLength);
-			FVector DistanceAsLocation = PolySpline->GetWorldLocationAtDistanceAlongSpline(RandomDistance);
-			DistanceAsLocation.Z = GetActorLocation().Z + HeightToAdd;
-			RandomPoints.Add(DistanceAsLocation);
-		}
+TArray<FVector> APolyZone::GetPoissonPointsInPolyZoneFromStream(FRandomStream& Stream, float MinSpacing, int MaxPoints, bool RandomHeight)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_RandomPoints);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::GetPoissonPointsInPolyZone);
+
+	if( !Shape.IsValid() )
+	{
+		return TArray<FVector>();
 	}
 
-	return RandomPoints;
+	TArray<FVector2D> LocalPoints;
+	FPolyZone_Sampling::PoissonDisk(*Shape, MinSpacing * ZoneFrame.InvScale, MaxPoints, Stream, LocalPoints);
+	return MakeWorldPoints(LocalPoints, RandomHeight, Stream);
 }
 
-// Copyright (c) 1970-2003, Wm. Randolph Franklin
-//
-// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
-// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
-// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
-//
-// 	Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimers.
-// 	Redistributions in binary form must reproduce the above copyright notice in the documentation and/or other materials provided with the distribution.
-// 	The name of W. Randolph Franklin may not be used to endorse or promote products derived from this Software without specific prior written permission. 
-//
-// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
-// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
-// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
-// OR OTHER DEALINGS IN THE SOFTWARE.
-// Original Code: https://wrfranklin.org/Research/Short_Notes/pnpoly.html
-bool APolyZone::IsPointWithinPolygon(FVector2D TestPoint)
+TArray<FVector> APolyZone::GetStratifiedPointsInPolyZone(float Spacing, float Jitter, bool RandomHeight)
 {
-	int NumPoints = Polygon.Num();
+	FRandomStream Stream(FMath::Rand());
+	return GetStratifiedPointsInPolyZoneFromStream(Stream, Spacing, Jitter, RandomHeight);
+}
 
-	bool InsidePoly = false;
-	for( int i = 0, j = NumPoints - 1; i < NumPoints; j = i++ )
+TArray<FVector> APolyZone::GetStratifiedPointsInPolyZoneFromStream(FRandomStream& Stream, float Spacing, float Jitter, bool RandomHeight)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_RandomPoints);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::GetStratifiedPointsInPolyZone);
+
+	if( !Shape.IsValid() )
 	{
-		FVector Point_i = Polygon[i];
-		FVector Point_j = Polygon[j];
-		if( (Point_i.Y > TestPoint.Y) != (Point_j.Y > TestPoint.Y) &&
-			TestPoint.X < (Point_j.X - Point_i.X) * (TestPoint.Y - Point_i.Y) / (Point_j.Y - Point_i.Y) + Point_i.X )
-		{
-			InsidePoly = !InsidePoly;
-		}
+		return TArray<FVector>();
 	}
 
-	return InsidePoly;
+	TArray<FVector2D> LocalPoints;
+	FPolyZone_Sampling::Stratified(*Shape, Spacing * ZoneFrame.InvScale, Jitter, Stream, LocalPoints);
+	return MakeWorldPoints(LocalPoints, RandomHeight, Stream);
 }
-// END MIT LICENSE
 
-bool APolyZone::IsPointInAABB_2D(const FVector2D& Point, const FVector2D& Min, const FVector2D& Max)
+// Local sample points to world, on the floor under each point or at a random height in the zone
+TArray<FVector> APolyZone::MakeWorldPoints(const TArray<FVector2D>& LocalPoints, bool RandomHeight, FRandomStream& Stream) const
 {
-	return Point.X >= Min.X && Point.X <= Max.X && Point.Y >= Min.Y && Point.Y <= Max.Y;
+	TArray<FVector> WorldPoints;
+	WorldPoints.Reserve(LocalPoints.Num());
+	for( const FVector2D& LocalPoint : LocalPoints )
+	{
+		const FFloatInterval FloorRange = HeightField.IsValid() ? HeightField->GetFloorRange(LocalPoint) : FFloatInterval(0.0f, 0.0f);
+		const float HeightToAdd = RandomHeight ? Stream.FRandRange(FloorRange.Min, FloorRange.Max + ZoneHeight) : FloorRange.Min;
+		WorldPoints.Add(ZoneFrame.ToWorld(LocalPoint, ZoneFrame.Origin.Z + HeightToAdd));
+	}
+	return WorldPoints;
 }
 
-float APolyZone::Cross2D(const FVector2D& A, const FVector2D& B, const FVector2D& C)
+TArray<FVector> APolyZone::GetRandomPointsAlongPolyZoneEdges(int NumPoints, bool RandomHeight)
 {
-	return (B.X - A.X) * (C.Y - A.Y) - (B.Y - A.Y) * (C.X - A.X);
+	TArray<FVector> RandomPoints;
+	RandomPoints.Reserve(FMath::Max(0, NumPoints));
+	for( const FPolyZone_EdgePoint& EdgePoint : GetRandomEdgePoints(NumPoints, RandomHeight) )
+	{
+		RandomPoints.Add(EdgePoint.Location);
+	}
+	return RandomPoints;
 }
 
-bool APolyZone::IsOnSegment2D(const FVector2D& A, const FVector2D& B, const FVector2D& P)
+TArray<FPolyZone_EdgePoint> APolyZone::GetRandomEdgePoints(int NumPoints, bool RandomHeight)
 {
-	return P.X >= FMath::Min(A.X, B.X) && P.X <= FMath::Max(A.X, B.X) &&
-		P.Y >= FMath::Min(A.Y, B.Y) && P.Y <= FMath::Max(A.Y, B.Y);
+	FRandomStream Stream(FMath::Rand());
+	return GetRandomEdgePointsFromStream(Stream, NumPoints, RandomHeight);
 }
 
-bool APolyZone::SegmentsIntersect2D(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D)
+TArray<FPolyZone_EdgePoint> APolyZone::GetRandomEdgePointsFromStream(FRandomStream& Stream, int NumPoints, bool RandomHeight)
 {
-	const float AB_C = Cross2D(A, B, C);
-	const float AB_D = Cross2D(A, B, D);
-	const float CD_A = Cross2D(C, D, A);
-	const float CD_B = Cross2D(C, D, B);
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_RandomPoints);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::GetRandomEdgePoints);
 
-	if( (AB_C == 0.0f && IsOnSegment2D(A, B, C)) || (AB_D == 0.0f && IsOnSegment2D(A, B, D)) ||
-		(CD_A == 0.0f && IsOnSegment2D(C, D, A)) || (CD_B == 0.0f && IsOnSegment2D(C, D, B)) )
+	TArray<FPolyZone_EdgePoint> EdgePoints;
+	if( !Shape.IsValid() || Shape->GetPerimeter() <= 0.0 )
 	{
-		return true;
+		return EdgePoints;
 	}
 
-	return (AB_C > 0.0f) != (AB_D > 0.0f) && (CD_A > 0.0f) != (CD_B > 0.0f);
+	const double Perimeter = Shape->GetPerimeter();
+	EdgePoints.Reserve(FMath::Max(0, NumPoints));
+	for( int i = 0; i < NumPoints; ++i )
+	{
+		const double Distance = Stream.GetFraction() * Perimeter;
+		EdgePoints.Add(MakeEdgePoint(Distance, RandomHeight ? Stream.FRandRange(0.0f, ZoneHeight) : 0.0f));
+	}
+	return EdgePoints;
 }
 
-FVector APolyZone::GetGridCellWorld(const FPolyZone_GridCell& Cell)
+TArray<FPolyZone_EdgePoint> APolyZone::GetEvenlySpacedEdgePoints(int NumPoints, float StartDistance)
 {
-	return GridOrigin + FVector(Cell.X * CellSize, Cell.Y * CellSize, 0.0f);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::GetEvenlySpacedEdgePoints);
+
+	TArray<FPolyZone_EdgePoint> EdgePoints;
+	if( !Shape.IsValid() || Shape->GetPerimeter() <= 0.0 || NumPoints <= 0 )
+	{
+		return EdgePoints;
+	}
+
+	const double Spacing = Shape->GetPerimeter() / NumPoints;
+	const double LocalStart = StartDistance * ZoneFrame.InvScale;
+	EdgePoints.Reserve(NumPoints);
+	for( int i = 0; i < NumPoints; ++i )
+	{
+		EdgePoints.Add(MakeEdgePoint(LocalStart + Spacing * i, 0.0f));
+	}
+	return EdgePoints;
 }
 
-FVector APolyZone::GetGridCellCenterWorld(const FPolyZone_GridCell& Cell)
+float APolyZone::GetPerimeterLength() const
 {
-	return GetGridCellWorld(Cell) + FVector(CellSize * 0.5f, CellSize * 0.5f, 0.0f);
+	return Shape.IsValid() ? Shape->GetPerimeter() * ZoneFrame.Scale : 0.0f;
 }
 
-FPolyZone_GridCell APolyZone::GetGridCellAtLocation(FVector Location)
+// Edge point at a local distance along the outline, HeightToAdd is above the floor under it
+FPolyZone_EdgePoint APolyZone::MakeEdgePoint(double LocalDistance, float HeightToAdd) const
 {
-	FTransform GridOriginTransform = FTransform(FVector(GridOrigin.X, GridOrigin.Y, 0.0f));
-	FVector LocationOnGrid = GridOriginTransform.InverseTransformPosition(Location);
-	int32 GridX = FMath::FloorToInt(LocationOnGrid.X / CellSize);
-	int32 GridY = FMath::FloorToInt(LocationOnGrid.Y / CellSize);
-	return FPolyZone_GridCell(GridX, GridY);
+	FPolyZone_EdgePoint EdgePoint;
+	FVector2D LocalNormal;
+	const FVector2D LocalPoint = Shape->GetPointAlongEdges(LocalDistance, EdgePoint.EdgeIndex, LocalNormal);
+
+	const float Floor = HeightField.IsValid() ? HeightField->GetFloorRange(LocalPoint).Min : 0.0f;
+	EdgePoint.Location = ZoneFrame.ToWorld(LocalPoint, ZoneFrame.Origin.Z + Floor + HeightToAdd);
+	EdgePoint.Normal = FVector(LocalNormal.X * ZoneFrame.AxisX.X - LocalNormal.Y * ZoneFrame.AxisX.Y, LocalNormal.X * ZoneFrame.AxisX.Y + LocalNormal.Y * ZoneFrame.AxisX.X, 0.0);
+	return EdgePoint;
 }
 
-int32 APolyZone::GetGridCellIndex(const FPolyZone_GridCell& Cell) const
+float APolyZone::GetFloorAtLocation(FVector Location) const
 {
-	if( Cell.X < 0 || Cell.Y < 0 || Cell.X >= GridCellsX || Cell.Y >= GridCellsY )
+	if( !HeightField.IsValid() )
 	{
-		return INDEX_NONE;
+		return ZoneFrame.Origin.Z;
 	}
+	return ZoneFrame.Origin.Z + HeightField->GetFloorRange(ZoneFrame.ToLocal(Location)).Min;
+}
 
-	return Cell.X + (Cell.Y * GridCellsX);
+FVector APolyZone::GetGridCellWorld(const FPolyZone_GridCell& Cell)
+{
+	if( !Shape.IsValid() )
+	{
+		return GridOrigin;
+	}
+	return ZoneFrame.ToWorld(Shape->GetGridCellLocal(Cell), ZoneFrame.Origin.Z);
+}
+
+FVector APolyZone::GetGridCellCenterWorld(const FPolyZone_GridCell& Cell)
+{
+	if( !Shape.IsValid() )
+	{
+		return GridOrigin;
+	}
+	const double HalfCellSize = Shape->CellSize * 0.5;
+	return ZoneFrame.ToWorld(Shape->GetGridCellLocal(Cell) + FVector2D(HalfCellSize, HalfCellSize), ZoneFrame.Origin.Z);
+}
+
+FPolyZone_GridCell APolyZone::GetGridCellAtLocation(FVector Location)
+{
+	if( !Shape.IsValid() )
+	{
+		return FPolyZone_GridCell();
+	}
+	return Shape->GetGridCellAtLocation(ZoneFrame.ToLocal(Location));
 }
 
 POLYZONE_CELL_FLAGS APolyZone::GetGridCellFlag(const FPolyZone_GridCell& Cell)
 {
-	const int32 CellIndex = GetGridCellIndex(Cell);
-	if( CellIndex == INDEX_NONE || !GridData.IsValidIndex(CellIndex) )
+	if( !Shape.IsValid() )
 	{
 		return POLYZONE_CELL_FLAGS::Outside;
 	}
-
-	return GridData[CellIndex];
+	return Shape->GetGridCellFlag(Cell);
 }
 
 POLYZONE_CELL_FLAGS APolyZone::GetFlagAtLocation(FVector Location)
 {
-	return GetGridCellFlag(GetGridCellAtLocation(Location));
+	if( !Shape.IsValid() )
+	{
+		return POLYZONE_CELL_FLAGS::Outside;
+	}
+	return Shape->GetCellFlagAtLocal(ZoneFrame.ToLocal(Location));
 }
 
-POLYZONE_CELL_FLAGS APolyZone::TestCellAgainstPolygon(FPolyZone_GridCell Cell)
+TArray<POLYZONE_CELL_FLAGS> APolyZone::GetFlagsAtLocations(const TArray<FVector>& Locations)
 {
-	const FVector CellCenterLocation_WS = GetGridCellCenterWorld(Cell);
-	const float HalfCellSize = CellSize * 0.5f;
-	const FVector2D CellMin(CellCenterLocation_WS.X - HalfCellSize, CellCenterLocation_WS.Y - HalfCellSize);
-	const FVector2D CellMax(CellCenterLocation_WS.X + HalfCellSize, CellCenterLocation_WS.Y + HalfCellSize);
+	TArray<POLYZONE_CELL_FLAGS> Flags;
+	if( !Shape.IsValid() )
+	{
+		Flags.Init(POLYZONE_CELL_FLAGS::Outside, Locations.Num());
+		return Flags;
+	}
 
-	int Corner = -1;
-	bool Result = false;
-	bool OnPolyEdge = false;
-	for( FVector2D CornerDir : CornerDirections )
+	TArray<FVector2D> LocalPoints;
+	LocalPoints.SetNumUninitialized(Locations.Num());
+	for( int32 i = 0; i < Locations.Num(); ++i )
 	{
-		FVector2D CellCorner;
-		CellCorner.X = CellCenterLocation_WS.X + HalfCellSize * CornerDir.X;
-		CellCorner.Y = CellCenterLocation_WS.Y + HalfCellSize * CornerDir.Y;
+		LocalPoints[i] = ZoneFrame.ToLocal(Locations[i]);
+	}
 
-		bool CurResult = IsPointWithinPolygon(CellCorner);
+	Flags.SetNumUninitialized(Locations.Num());
+	Shape->GetCellFlagsAtLocal(LocalPoints, Flags);
+	return Flags;
+}
 
-		Corner++;
-		if( Corner == 0 ) // First test
-		{
-			Result = CurResult;
-		}
-		else
-		{
-			if( CurResult != Result )
-			{
-				OnPolyEdge = true;
-				break;
-			}
-		}
+TArray<POLYZONE_CELL_FLAGS> APolyZone::GetGridData() const
+{
+	if( !Shape.IsValid() )
+	{
+		return TArray<POLYZONE_CELL_FLAGS>();
 	}
+	return Shape->GridData;
+}
 
-	if( OnPolyEdge )
+int32 APolyZone::GetGridCellComponent(const FPolyZone_GridCell& Cell)
+{
+	return Shape.IsValid() ? Shape->GetCellComponent(Shape->GetGridCellIndex(Cell)) : INDEX_NONE;
+}
+
+TArray<FPolyZone_GridCell> APolyZone::FloodFillGrid(const FPolyZone_GridCell& StartCell, bool AllowEdgeCells, int32 MaxCells)
+{
+	TArray<FPolyZone_GridCell> Cells;
+	if( !Shape.IsValid() || !GridSearch.FloodFill(*Shape, Shape->GetGridCellIndex(StartCell), AllowEdgeCells, GridSearchCells, MaxCells > 0 ? MaxCells : MAX_int32) )
 	{
-		return POLYZONE_CELL_FLAGS::OnEdge;
+		return Cells;
 	}
-	if( Result )
+
+	Cells.Reserve(GridSearchCells.Num());
+	for( const int32 CellIndex : GridSearchCells )
 	{
-		return POLYZONE_CELL_FLAGS::Within;
+		Cells.Add(FPolyZone_GridCell(CellIndex % Shape->GridCellsX, CellIndex / Shape->GridCellsX));
+	}
+	return Cells;
+}
+
+bool APolyZone::FindGridPath(const FPolyZone_GridCell& StartCell, const FPolyZone_GridCell& GoalCell, TArray<FPolyZone_GridCell>& Path, bool AllowDiagonal, bool AllowEdgeCells)
+{
+	Path.Reset();
+	if( !Shape.IsValid() )
+	{
+		return false;
 	}
 
-	// Any polygon vertex inside the cell?
-	const int32 NumPoints = Polygon2D.Num();
-	for( int32 i = 0; i < NumPoints; ++i )
+	const int32 StartIndex = Shape->GetGridCellIndex(StartCell);
+	const int32 GoalIndex = Shape->GetGridCellIndex(GoalCell);
+	const bool FoundPath = AllowDiagonal ? GridSearch.FindPathAStar(*Shape, StartIndex, GoalIndex, AllowEdgeCells, GridSearchCells)
+		: GridSearch.FindPathBFS(*Shape, StartIndex, GoalIndex, AllowEdgeCells, GridSearchCells);
+	if( FoundPath )
 	{
-		if( IsPointInAABB_2D(Polygon2D[i], CellMin, CellMax) )
+		Path.Reserve(GridSearchCells.Num());
+		for( const int32 CellIndex : GridSearchCells )
 		{
-			return POLYZONE_CELL_FLAGS::OnEdge;
+			Path.Add(FPolyZone_GridCell(CellIndex % Shape->GridCellsX, CellIndex / Shape->GridCellsX));
 		}
 	}
+	return FoundPath;
+}
 
-	// Any polygon edge intersects any cell edge?
-	const FVector2D CellTL(CellMin.X, CellMax.Y);
-	const FVector2D CellTR(CellMax.X, CellMax.Y);
-	const FVector2D CellBR(CellMax.X, CellMin.Y);
-	const FVector2D CellBL(CellMin.X, CellMin.Y);
+bool APolyZone::FindNearestWithinCell(FVector Location, FPolyZone_GridCell& Cell, bool AllowEdgeCells)
+{
+	if( !Shape.IsValid() )
+	{
+		return false;
+	}
 
-	for( int32 i = 0; i < NumPoints; ++i )
+	const int32 CellIndex = FPolyZone_GridSearch::FindNearestWalkableCell(*Shape, ZoneFrame.ToLocal(Location), AllowEdgeCells);
+	if( CellIndex == INDEX_NONE )
 	{
-		const FVector2D& A = Polygon2D[i];
-		const FVector2D& B = Polygon2D[(i + 1) % NumPoints];
+		return false;
+	}
+	Cell = FPolyZone_GridCell(CellIndex % Shape->GridCellsX, CellIndex / Shape->GridCellsX);
+	return true;
+}
 
-		if( SegmentsIntersect2D(A, B, CellTL, CellTR) || SegmentsIntersect2D(A, B, CellTR, CellBR) ||
-			SegmentsIntersect2D(A, B, CellBR, CellBL) || SegmentsIntersect2D(A, B, CellBL, CellTL) )
-		{
-			return POLYZONE_CELL_FLAGS::OnEdge;
-		}
+TArray<FPolyZone_GridCell> APolyZone::GetAllGridCells()
+{
+	if( !Shape.IsValid() )
+	{
+		return TArray<FPolyZone_GridCell>();
 	}
+	return Shape->GetAllGridCells();
+}
 
-	return POLYZONE_CELL_FLAGS::Outside;
+int32 APolyZone::GetCellOccupancy(const FPolyZone_GridCell& Cell) const
+{
+	return Shape.IsValid() ? Occupancy.GetCount(Shape->GetGridCellIndex(Cell)) : 0;
 }
 
-TArray<FPolyZone_GridCell> APolyZone::GetAllGridCells()
+float APolyZone::GetCellOccupancyHistory(const FPolyZone_GridCell& Cell) const
 {
-	TArray<FPolyZone_GridCell> Coords;
-	if( GridCellsX <= 0 || GridCellsY <= 0 )
+	const UWorld* World = GetWorld(); // Null on the CDO and on zones outside a world
+	return Shape.IsValid() && World ? Occupancy.GetHistory(Shape->GetGridCellIndex(Cell), World->GetTimeSeconds()) : 0.0f;
+}
+
+TArray<FPolyZone_GridCell> APolyZone::GetDensestCells(int32 MaxCells, bool UseHistory) const
+{
+	TArray<FPolyZone_GridCell> DensestCells;
+	const UWorld* World = GetWorld();
+	if( !Shape.IsValid() || !Occupancy.IsValid() || !World )
 	{
-		return Coords;
+		return DensestCells;
 	}
 
-	const int32 NumCells = GridData.Num();
-	Coords.Reserve(NumCells);
-	for( int32 Index = 0; Index < NumCells; ++Index )
+	TArray<int32> CellIndices;
+	Occupancy.GetDensestCells(MaxCells, UseHistory, World->GetTimeSeconds(), CellIndices);
+	for( const int32 CellIndex : CellIndices )
 	{
-		if( GridData[Index] == POLYZONE_CELL_FLAGS::Outside )
-		{
-			continue;
-		}
+		DensestCells.Add(FPolyZone_GridCell(CellIndex % Shape->GridCellsX, CellIndex / Shape->GridCellsX));
+	}
+	return DensestCells;
+}
 
-		const int32 GridX = Index % GridCellsX;
-		const int32 GridY = Index / GridCellsX;
-		Coords.Add(FPolyZone_GridCell(GridX, GridY));
+bool APolyZone::ExportOccupancyCsv(FString FilePath)
+{
+	const UWorld* World = GetWorld();
+	if( !Occupancy.IsValid() || !World )
+	{
+		return false;
 	}
-	return Coords;
+
+	if( FilePath.IsEmpty() )
+	{
+		FilePath = FPaths::ProjectSavedDir() / TEXT("PolyZoneOccupancy") / FString::Printf(TEXT("%s_%s.csv"), *GetName(), *FDateTime::Now().ToString());
+	}
+	return FFileHelper::SaveStringToFile(Occupancy.ToCsv(World->GetTimeSeconds()), *FilePath);
+}
+
+UTexture2D* APolyZone::CreateOccupancyTexture(bool UseHistory) const
+{
+	const UWorld* World = GetWorld();
+	return World ? Occupancy.CreateTexture(UseHistory, World->GetTimeSeconds()) : nullptr;
 }
 
 void APolyZone::OnBeginBoundsOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex,
@@ -665,27 +1214,88 @@ void APolyZone::OnEndBoundsOverlap(UPrimitiveComponent* OverlappedComp, AActor*
 // Track actors within bounds
 void APolyZone::DoActorTracking()
 {
+	if( IsMembershipFromServer() )
+	{
+		return; // The server tracks for us
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_ActorTracking);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::DoActorTracking);
+	CSV_SCOPED_TIMING_STAT(PolyZones, ActorTracking);
+	TrackingFrame = GFrameCounter;
+	INC_DWORD_STAT_BY(STAT_PolyZone_TrackedActors, TrackedActors.Num());
+	CSV_CUSTOM_STAT(PolyZones, TrackedActors, TrackedActors.Num(), ECsvCustomStatOp::Accumulate);
+
 	// We cannot notify while in the TMap loop, because the notifies may cause the map to change
 	TArray<TPair<AActor*, bool>> ActorsToNotify;
 
-	// Check if each tracked actor is within the polyzone
+	// Gather every tracked actor, so the shape can test them all in one batch
+	TrackingPoints.Reset();
+	TrackingHeights.Reset();
 	for( const TPair<AActor*, bool>& MapPair : TrackedActors )
 	{
-		if( !IsValid(this) ) { break; }
-
 		AActor* TrackedActor = MapPair.Key;
-		bool IsWithinPoly = MapPair.Value;
 		if( IsValid(TrackedActor) ) // TMap magically removes invalid actors but this is for my sanity
 		{
-			bool NewIsWithinPoly = IsActorWithinPolyZone(TrackedActor, true);
-			if( NewIsWithinPoly != IsWithinPoly )
+			const FVector ActorLocation = TrackedActor->GetActorLocation();
+			TrackingPoints.Add(ZoneFrame.ToLocal(ActorLocation));
+			if( HeightField.IsValid() )
 			{
-				TrackedActors[TrackedActor] = NewIsWithinPoly;
-				ActorsToNotify.Add(MapPair); // If our status has changed, we should notify the interface
+				TrackingHeights.Add(ActorLocation.Z - ZoneFrame.Origin.Z);
 			}
 		}
 	}
 
+	TrackingResults.SetNumUninitialized(TrackingPoints.Num());
+	if( Shape.IsValid() )
+	{
+		INC_DWORD_STAT_BY(STAT_PolyZone_PointQueries, TrackingPoints.Num());
+		Shape->ArePointsWithinShape(TrackingPoints, TrackingResults);
+
+		// The overlap box spans every floor of the zone, the cell floors are what count
+		if( HeightField.IsValid() )
+		{
+			for( int32 i = 0; i < TrackingPoints.Num(); ++i )
+			{
+				TrackingResults[i] = TrackingResults[i] && FPolyZone_HeightField::IsWithinZoneHeight(HeightField.Get(), TrackingPoints[i], TrackingHeights[i], ZoneHeight);
+			}
+		}
+	}
+	else
+	{
+		FMemory::Memzero(TrackingResults.GetData(), TrackingResults.Num() * sizeof(bool));
+	}
+
+	// Check if each tracked actor is within the polyzone, the map hasn't changed so it walks in the same order as above
+	// Cached results let IsActorWithinPolyZone calls this frame skip the test, flat zones leave the height to the overlap box so only the 2D result is known
+	const bool CacheResults = Shape.IsValid() && PrepareQueryCache();
+	int32 ResultIndex = 0;
+	for( TPair<AActor*, bool>& MapPair : TrackedActors )
+	{
+		if( !IsValid(MapPair.Key) )
+		{
+			continue;
+		}
+
+		const bool NewIsWithinPoly = TrackingResults[ResultIndex];
+		if( Occupancy.IsValid() )
+		{
+			const int32 CellIndex = NewIsWithinPoly ? Shape->GetGridCellIndex(Shape->GetGridCellAtLocation(TrackingPoints[ResultIndex])) : INDEX_NONE;
+			Occupancy.SetActorCell(MapPair.Key, CellIndex, GetWorld()->GetTimeSeconds());
+		}
+		ResultIndex++;
+		if( CacheResults )
+		{
+			AddCachedQuery(MapPair.Key->GetActorLocation(), !HeightField.IsValid(), NewIsWithinPoly);
+		}
+
+		if( NewIsWithinPoly != MapPair.Value )
+		{
+			MapPair.Value = NewIsWithinPoly;
+			ActorsToNotify.Add(MapPair); // If our status has changed, we should notify the interface
+		}
+	}
+
 	if( ActorTracking ) // Only notify actors if actor tracking is enabled (this function might have been called from 'get' functions)
 	{
 		// Now that we know which actors have changed, we can notify their interfaces
@@ -694,10 +1304,19 @@ void APolyZone::DoActorTracking()
 			PolyZoneOverlapChange(ActorStatus.Key, ActorStatus.Value);
 		}
 	}
+
+	INC_DWORD_STAT_BY(STAT_PolyZone_ActorsInZones, ActorsInPolyZone.Num());
+	CSV_CUSTOM_STAT(PolyZones, ActorsInZones, ActorsInPolyZone.Num(), ECsvCustomStatOp::Accumulate);
 }
 
 void APolyZone::PolyZoneOverlapChange(AActor* TrackedActor, bool NewIsOverlapped)
 {
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_EventDispatch);
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::PolyZoneOverlapChange);
+	CSV_SCOPED_TIMING_STAT(PolyZones, EventDispatch);
+	INC_DWORD_STAT(STAT_PolyZone_Events);
+	CSV_CUSTOM_STAT(PolyZones, Events, 1, ECsvCustomStatOp::Accumulate);
+
 	if( NewIsOverlapped )
 	{
 		ActorsInPolyZone.Add(TrackedActor);
@@ -707,6 +1326,28 @@ void APolyZone::PolyZoneOverlapChange(AActor* TrackedActor, bool NewIsOverlapped
 	{
 		ActorsInPolyZone.Remove(TrackedActor);
 		OnExitPolyZone(TrackedActor);
+		if( Occupancy.IsValid() )
+		{
+			Occupancy.SetActorCell(TrackedActor, INDEX_NONE, GetWorld()->GetTimeSeconds()); // Left through the bounds, tracking won't see it again
+		}
+	}
+
+	if( UPolyZone_Subsystem* ZoneSubsystem = UPolyZone_Subsystem::Get(this) )
+	{
+		ZoneSubsystem->OnMembershipChange(TrackedActor, this, NewIsOverlapped);
+	}
+
+	// Replicate the change, clients fire their own events when it arrives
+	if( bReplicateMembership && HasAuthority() )
+	{
+		if( NewIsOverlapped )
+		{
+			ReplicatedMembers.AddMember(TrackedActor);
+		}
+		else
+		{
+			ReplicatedMembers.RemoveMember(TrackedActor);
+		}
 	}
 
 	IPolyZone_Interface* ZoneInterface = Cast<IPolyZone_Interface>(TrackedActor);
@@ -720,30 +1361,86 @@ void APolyZone::PolyZoneOverlapChange(AActor* TrackedActor, bool NewIsOverlapped
 	}
 }
 
+void APolyZone::OnReplicatedMemberChange(AActor* Member, bool NewIsOverlapped)
+{
+	if( !IsValid(Member) || !Member->Implements<UPolyZone_Interface>() )
+	{
+		return;
+	}
+	if( NewIsOverlapped == ActorsInPolyZone.Contains(Member) )
+	{
+		return; // Already in that state, the end play exits may have run first
+	}
+	PolyZoneOverlapChange(Member, NewIsOverlapped);
+}
+
 void APolyZone::DrawDebugGrid()
 {
-	if( !UsesGrid || GridCellsX <= 0 || GridCellsY <= 0 )
+	if( !bDebugGrid )
 	{
+		if( IsValid(DebugGridLines) && DebugGridLines->BatchedLines.Num() > 0 )
+		{
+			DebugGridLines->Flush();
+			DebugGridDirty = true;
+		}
 		return;
 	}
 
-	UWorld* World = GetWorld();
-	if( !World )
+	if( !Shape.IsValid() || !Shape->UsesGrid || Shape->GridCellsX <= 0 || Shape->GridCellsY <= 0 || !GetWorld() )
 	{
 		return;
 	}
 
-	const float HalfCellSize = CellSize * 0.5f;
+	if( DebugGridDirty )
+	{
+		Build_DebugGrid();
+	}
+
+	// Only the occupied cells are drawn per frame, there are at most as many as actors in the zone
+	const double HalfCellSize = Shape->CellSize * 0.5;
+	const FVector CellExtent(CellSize * 0.5, CellSize * 0.5, 10.0f);
+	const FQuat CellRotation = ZoneFrame.GetRotation();
+	for( const AActor* Actor : ActorsInPolyZone )
+	{
+		if( !IsValid(Actor) )
+		{
+			continue;
+		}
+
+		const FPolyZone_GridCell Cell = Shape->GetGridCellAtLocation(ZoneFrame.ToLocal(Actor->GetActorLocation()));
+		if( Shape->GetGridCellIndex(Cell) != INDEX_NONE )
+		{
+			const FVector CellCenter = ZoneFrame.ToWorld(Shape->GetGridCellLocal(Cell) + FVector2D(HalfCellSize, HalfCellSize), GridOrigin.Z);
+			DrawDebugBox(GetWorld(), CellCenter, CellExtent, CellRotation, FColor::Cyan, false, 0.0f, 0, 3.0f);
+		}
+	}
+}
+
+// Every cell outline goes into one line batch, which keeps its render proxy until the next rebuild or move
+void APolyZone::Build_DebugGrid()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(APolyZone::Build_DebugGrid);
+	DebugGridDirty = false;
+
+	if( !IsValid(DebugGridLines) )
+	{
+		DebugGridLines = NewObject<ULineBatchComponent>(this, TEXT("DebugGridLines"), RF_Transient);
+		DebugGridLines->RegisterComponent(); // Lines are in world space, so it doesn't need attaching
+	}
+	DebugGridLines->Flush();
+
 	const float LineThickness = 1.0f;
-	const float ShrunkHalfSize = FMath::Max(0.0f, HalfCellSize - (LineThickness * 0.5f));
-	const FVector CellExtent(ShrunkHalfSize, ShrunkHalfSize, 5.0f);
+	const double LocalCellSize = Shape->CellSize;
+	const double Inset = FMath::Min(LocalCellSize * 0.5, LineThickness * 0.5 * ZoneFrame.InvScale); // Keeps the outlines of neighbouring cells apart
+	const double WorldZ = GridOrigin.Z;
 
-	for( int32 GridX = 0; GridX < GridCellsX; GridX++ )
+	TArray<FBatchedLine> Lines;
+	Lines.Reserve(Shape->GridData.Num() * 4);
+	for( int32 GridY = 0; GridY < Shape->GridCellsY; GridY++ )
 	{
-		for( int32 GridY = 0; GridY < GridCellsY; GridY++ )
+		for( int32 GridX = 0; GridX < Shape->GridCellsX; GridX++ )
 		{
-			const FPolyZone_GridCell Cell(GridX, GridY);
-			const POLYZONE_CELL_FLAGS CellFlag = GetGridCellFlag(Cell);
+			const POLYZONE_CELL_FLAGS CellFlag = Shape->GridData[GridX + GridY * Shape->GridCellsX];
 
 			FColor CellColor = FColor::White;
 			if( CellFlag == POLYZONE_CELL_FLAGS::Within )
@@ -755,9 +1452,19 @@ void APolyZone::DrawDebugGrid()
 				CellColor = FColor::Yellow;
 			}
 
-			FVector CellCenter = GetGridCellCenterWorld(Cell);
-			CellCenter.Z = GridOrigin.Z;
-			DrawDebugBox(World, CellCenter, CellExtent, CellColor, false, 0.0f, 0, LineThickness);
+			const FVector2D CellMin = Shape->GridOrigin + FVector2D(GridX * LocalCellSize + Inset, GridY * LocalCellSize + Inset);
+			const FVector2D CellMax = CellMin + FVector2D(LocalCellSize - Inset * 2.0, LocalCellSize - Inset * 2.0);
+			const FVector Corners[4] = {
+				ZoneFrame.ToWorld(CellMin, WorldZ),
+				ZoneFrame.ToWorld(FVector2D(CellMax.X, CellMin.Y), WorldZ),
+				ZoneFrame.ToWorld(CellMax, WorldZ),
+				ZoneFrame.ToWorld(FVector2D(CellMin.X, CellMax.Y), WorldZ)
+			};
+			for( int32 Corner = 0; Corner < 4; Corner++ )
+			{
+				Lines.Emplace(Corners[Corner], Corners[(Corner + 1) % 4], FLinearColor(CellColor), 0.0f, LineThickness, SDPG_World); // No lifetime, kept until flushed
+			}
 		}
 	}
+	DebugGridLines->DrawLines(Lines);
 }
@@ -0,0 +1,445 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_BenchmarkCommandlet.h"
+#include "PolyZone.h"
+#include "PolyZones_Plugin.h"
+#include "Dom/JsonObject.h"
+#include "Engine/World.h"
+#include "Interfaces/IPluginManager.h"
+#include "Math/RandomStream.h"
+#include "Misc/App.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	volatile int64 BenchmarkSink = 0; // Keeps the compiler from dropping the timed work
+
+	constexpr double BenchmarkZoneRadius = 5000.0;
+	constexpr int32 MaxQueryPointTries = 1000; // Rejection sampling gives up on shapes with (almost) no area
+
+	struct FBenchmarkZoneCase
+	{
+		const TCHAR* Name;
+		int32 NumVertices;
+		double InnerRatio; // 1 is a regular (convex) polygon, anything lower is a concave star
+		bool DecomposeConcave;
+	};
+
+	const TCHAR* QueryMixNames[] = { TEXT("Inside"), TEXT("Outside"), TEXT("Edge"), TEXT("Mixed") };
+
+	TArray<FVector2D> MakeStarPolygon(int32 NumVertices, double Radius, double InnerRatio)
+	{
+		TArray<FVector2D> Polygon;
+		Polygon.Reserve(NumVertices);
+		for( int32 i = 0; i < NumVertices; ++i )
+		{
+			const double Angle = (2.0 * PI * i) / NumVertices;
+			const double PointRadius = (i % 2 == 1) ? Radius * InnerRatio : Radius;
+			Polygon.Add(FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * PointRadius);
+		}
+		return Polygon;
+	}
+
+	// Mix 0 is inside, 1 is outside (but near the zone) and 2 is within 1cm of an edge, the slowest case for the grid
+	FVector MakeQueryPoint(const APolyZone* Zone, int32 Mix, FRandomStream& Stream)
+	{
+		const FPolyZone_Shape& Shape = *Zone->GetShape();
+		const FPolyZone_Frame& Frame = Zone->GetZoneFrame();
+		const double WorldZ = Frame.Origin.Z + Stream.FRandRange(0.0f, Zone->ZoneHeight);
+		const FVector2D BoundsCenter = (Shape.BoundsMin + Shape.BoundsMax) * 0.5;
+		if( Shape.Polygon.Num() < 3 )
+		{
+			return Frame.ToWorld(BoundsCenter, WorldZ);
+		}
+
+		if( Mix == 2 )
+		{
+			const int32 EdgeIndex = Stream.RandHelper(Shape.Polygon.Num());
+			const FVector2D& A = Shape.Polygon[EdgeIndex];
+			const FVector2D& B = Shape.Polygon[(EdgeIndex + 1) % Shape.Polygon.Num()];
+			const FVector2D Normal = FVector2D(B.Y - A.Y, A.X - B.X).GetSafeNormal();
+			const FVector2D EdgePoint = FMath::Lerp(A, B, static_cast<double>(Stream.FRand())) + Normal * Stream.FRandRange(-1.0f, 1.0f);
+			return Frame.ToWorld(EdgePoint, WorldZ);
+		}
+
+		const FVector2D Padding = (Mix == 1) ? (Shape.BoundsMax - Shape.BoundsMin) * 0.25 : FVector2D::ZeroVector;
+		const FVector2D Min = Shape.BoundsMin - Padding;
+		const FVector2D Max = Shape.BoundsMax + Padding;
+		const bool WantsInside = (Mix == 0);
+		for( int32 Try = 0; Try < MaxQueryPointTries; ++Try )
+		{
+			const FVector2D LocalPoint(Stream.FRandRange(Min.X, Max.X), Stream.FRandRange(Min.Y, Max.Y));
+			if( Shape.IsPointWithinPolygon(LocalPoint) == WantsInside )
+			{
+				return Frame.ToWorld(LocalPoint, WorldZ);
+			}
+		}
+		return Frame.ToWorld(BoundsCenter, WorldZ); // Degenerate shape, any point will do for timing
+	}
+
+	// Runs Setup untimed and Body timed once per iteration, after one warm up run
+	template<typename SetupType, typename BodyType>
+	FPolyZone_BenchmarkResult Measure(const TCHAR* Suite, const FString& Case, int32 Size, int64 OpsPerIteration, int32 Iterations, SetupType&& Setup, BodyType&& Body)
+	{
+		Setup();
+		Body();
+
+		TArray<double> Samples;
+		Samples.Reserve(Iterations);
+		for( int32 i = 0; i < Iterations; ++i )
+		{
+			Setup();
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			Body();
+			Samples.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles));
+		}
+		Samples.Sort();
+
+		FPolyZone_BenchmarkResult Result;
+		Result.Suite = Suite;
+		Result.Case = Case;
+		Result.Size = Size;
+		Result.OpsPerIteration = OpsPerIteration;
+		Result.Iterations = Iterations;
+		Result.MinMs = Samples[0];
+		Result.MedianMs = Samples[Samples.Num() / 2];
+		Result.MaxMs = Samples.Last();
+
+		UE_LOG(LogPolyZones, Display, TEXT("%-10s %-24s %6d  median %10.4f ms  %10.2f ns/op"), Suite, *Case, Size, Result.MedianMs, Result.GetNsPerOp());
+		return Result;
+	}
+}
+
+APolyZone_BenchmarkActor::APolyZone_BenchmarkActor()
+{
+	PrimaryActorTick.bCanEverTick = false;
+	SetRootComponent(CreateDefaultSubobject<USceneComponent>(TEXT("SceneComp")));
+}
+
+UPolyZone_BenchmarkCommandlet::UPolyZone_BenchmarkCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UPolyZone_BenchmarkCommandlet::Main(const FString& Params)
+{
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Queries="), NumQueries);
+	FParse::Value(*Params, TEXT("Seed="), Seed);
+	Iterations = FMath::Max(1, Iterations);
+	NumQueries = FMath::Max(1, NumQueries);
+
+	FString OutputDir = FPaths::ProjectSavedDir() / TEXT("PolyZoneBenchmarks");
+	FParse::Value(*Params, TEXT("Output="), OutputDir);
+
+	FString SuitesParam;
+	TArray<FString> Suites;
+	if( FParse::Value(*Params, TEXT("Suites="), SuitesParam) )
+	{
+		SuitesParam.ParseIntoArray(Suites, TEXT(","));
+	}
+	auto WantsSuite = [&Suites](const TCHAR* Suite) { return Suites.Num() == 0 || Suites.Contains(Suite); };
+
+	// A bare world is enough, zones are spawned but never begin play
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false, TEXT("PolyZoneBenchmark"));
+	if( !World )
+	{
+		UE_LOG(LogPolyZones, Error, TEXT("PolyZone benchmark could not create a world"));
+		return 1;
+	}
+
+	Results.Reset();
+	if( WantsSuite(TEXT("Query")) ) RunQuerySuite(World);
+	if( WantsSuite(TEXT("Build")) ) RunBuildSuite();
+	if( WantsSuite(TEXT("Tracking")) ) RunTrackingSuite(World);
+	if( WantsSuite(TEXT("Sampling")) ) RunSamplingSuite(World);
+
+	World->DestroyWorld(false);
+
+	return WriteResults(OutputDir) ? 0 : 1;
+}
+
+// IsPointWithinPolyZone throughput for each query path and point mix
+void UPolyZone_BenchmarkCommandlet::RunQuerySuite(UWorld* World)
+{
+	const FBenchmarkZoneCase ZoneCases[] = {
+		{ TEXT("Convex8"), 8, 1.0, false },
+		{ TEXT("Convex64"), 64, 1.0, false },
+		{ TEXT("Star16"), 16, 0.5, false },
+		{ TEXT("Star16_Pieces"), 16, 0.5, true },
+		{ TEXT("Star64"), 64, 0.5, false },
+		{ TEXT("Star512"), 512, 0.5, false }
+	};
+
+	FRandomStream Stream(Seed);
+	for( const FBenchmarkZoneCase& ZoneCase : ZoneCases )
+	{
+		APolyZone* Zone = SpawnZone(World, MakeStarPolygon(ZoneCase.NumVertices, BenchmarkZoneRadius, ZoneCase.InnerRatio), ZoneCase.DecomposeConcave);
+		if( !Zone || !Zone->GetShape().IsValid() )
+		{
+			continue;
+		}
+
+		for( int32 Mix = 0; Mix < UE_ARRAY_COUNT(QueryMixNames); ++Mix )
+		{
+			TArray<FVector> Points;
+			Points.Reserve(NumQueries);
+			for( int32 i = 0; i < NumQueries; ++i )
+			{
+				Points.Add(MakeQueryPoint(Zone, (Mix == 3) ? Stream.RandHelper(3) : Mix, Stream));
+			}
+
+			Results.Add(Measure(TEXT("Query"), FString::Printf(TEXT("%s_%s"), ZoneCase.Name, QueryMixNames[Mix]), ZoneCase.NumVertices, Points.Num(), Iterations, []() {},
+				[Zone, &Points]()
+				{
+					int64 Hits = 0;
+					for( const FVector& Point : Points )
+					{
+						Hits += Zone->IsPointWithinPolyZone(Point) ? 1 : 0;
+					}
+					BenchmarkSink = Hits;
+				}));
+		}
+		Zone->Destroy();
+	}
+}
+
+// Shape build time (simplification, query path and grid) across vertex counts and zone sizes, the shape cache is bypassed
+void UPolyZone_BenchmarkCommandlet::RunBuildSuite()
+{
+	const int32 VertexCounts[] = { 8, 32, 128, 512, 2048 };
+	const double Radii[] = { 1000.0, 10000.0, 100000.0 };
+
+	for( const int32 NumVertices : VertexCounts )
+	{
+		const int32 BuildIterations = (NumVertices >= 2048) ? FMath::Max(1, Iterations / 4) : Iterations;
+		for( const double Radius : Radii )
+		{
+			const TArray<FVector2D> Polygon = MakeStarPolygon(NumVertices, Radius, 0.5);
+			const FPolyZone_ShapeSettings Settings;
+			Results.Add(Measure(TEXT("Build"), FString::Printf(TEXT("Star_R%d"), FMath::RoundToInt(Radius)), NumVertices, 1, BuildIterations, []() {},
+				[&Polygon, &Settings]()
+				{
+					BenchmarkSink = FPolyZone_Shape::BuildUncached(Polygon, Settings)->GridData.Num();
+				}));
+		}
+
+		const TArray<FVector2D> Polygon = MakeStarPolygon(NumVertices, BenchmarkZoneRadius, 0.5);
+		FPolyZone_ShapeSettings Settings;
+		Settings.bDecomposeConcave = true;
+		Settings.MaxConvexPieces = NumVertices;
+		Results.Add(Measure(TEXT("Build"), TEXT("Star_Pieces"), NumVertices, 1, BuildIterations, []() {},
+			[&Polygon, &Settings]()
+			{
+				BenchmarkSink = FPolyZone_Shape::BuildUncached(Polygon, Settings)->ConvexPieces.Num();
+			}));
+	}
+}
+
+// DoActorTracking cost against the number of tracked actors, with no changes (Steady) and with every actor entering or exiting (Churn)
+void UPolyZone_BenchmarkCommandlet::RunTrackingSuite(UWorld* World)
+{
+	const int32 ActorCounts[] = { 10, 100, 1000, 10000 };
+
+	APolyZone* Zone = SpawnZone(World, MakeStarPolygon(64, BenchmarkZoneRadius, 0.5), false);
+	if( !Zone || !Zone->GetShape().IsValid() )
+	{
+		return;
+	}
+
+	FRandomStream Stream(Seed);
+	for( const int32 NumActors : ActorCounts )
+	{
+		TArray<AActor*> Actors;
+		Actors.Reserve(NumActors);
+		for( int32 i = 0; i < NumActors; ++i )
+		{
+			const FVector Location = MakeQueryPoint(Zone, Stream.RandHelper(2), Stream);
+			Actors.Add(World->SpawnActor<APolyZone_BenchmarkActor>(Location, FRotator::ZeroRotator));
+		}
+
+		// Fill the tracking map directly, there are no physics overlaps without begin play
+		Zone->TrackedActors.Reset();
+		Zone->ActorsInPolyZone.Reset();
+		for( AActor* Actor : Actors )
+		{
+			Zone->TrackedActors.Add(Actor, false);
+		}
+		Zone->DoActorTracking();
+
+		Results.Add(Measure(TEXT("Tracking"), TEXT("Steady"), NumActors, NumActors, Iterations, []() {},
+			[Zone]()
+			{
+				Zone->DoActorTracking();
+			}));
+
+		Results.Add(Measure(TEXT("Tracking"), TEXT("Churn"), NumActors, NumActors, Iterations,
+			[Zone]()
+			{
+				// Flip every actor, so the next update notifies all of them
+				Zone->ActorsInPolyZone.Reset();
+				for( TPair<AActor*, bool>& MapPair : Zone->TrackedActors )
+				{
+					MapPair.Value = !MapPair.Value;
+					if( MapPair.Value )
+					{
+						Zone->ActorsInPolyZone.Add(MapPair.Key);
+					}
+				}
+			},
+			[Zone]()
+			{
+				Zone->DoActorTracking();
+			}));
+
+		Zone->TrackedActors.Reset();
+		Zone->ActorsInPolyZone.Reset();
+		for( AActor* Actor : Actors )
+		{
+			if( IsValid(Actor) )
+			{
+				Actor->Destroy();
+			}
+		}
+	}
+	Zone->Destroy();
+}
+
+// GetRandomPointsInPolyZone (the sparse star rejects most of its samples), edge sampling and the even distributions
+void UPolyZone_BenchmarkCommandlet::RunSamplingSuite(UWorld* World)
+{
+	const FBenchmarkZoneCase ZoneCases[] = {
+		{ TEXT("Convex64"), 64, 1.0, false },
+		{ TEXT("SparseStar64"), 64, 0.2, false }
+	};
+	const int32 PointCounts[] = { 16, 256, 4096 };
+
+	FMath::RandInit(Seed); // Sampling uses the global random stream
+	for( const FBenchmarkZoneCase& ZoneCase : ZoneCases )
+	{
+		APolyZone* Zone = SpawnZone(World, MakeStarPolygon(ZoneCase.NumVertices, BenchmarkZoneRadius, ZoneCase.InnerRatio), ZoneCase.DecomposeConcave);
+		if( !Zone || !Zone->GetShape().IsValid() )
+		{
+			continue;
+		}
+
+		for( const int32 NumPoints : PointCounts )
+		{
+			Results.Add(Measure(TEXT("Sampling"), ZoneCase.Name, NumPoints, NumPoints, Iterations, []() {},
+				[Zone, NumPoints]()
+				{
+					BenchmarkSink = Zone->GetRandomPointsInPolyZone(NumPoints, true).Num();
+				}));
+			Results.Add(Measure(TEXT("Sampling"), FString::Printf(TEXT("%s_Edges"), ZoneCase.Name), NumPoints, NumPoints, Iterations, []() {},
+				[Zone, NumPoints]()
+				{
+					BenchmarkSink = Zone->GetRandomEdgePoints(NumPoints, true).Num();
+				}));
+
+			// Spacing that fits about NumPoints into the zone
+			const float Spacing = FMath::Sqrt(FMath::Abs(FPolyZone_Geometry::SignedArea(Zone->GetShape()->Polygon)) / NumPoints);
+			Results.Add(Measure(TEXT("Sampling"), FString::Printf(TEXT("%s_Poisson"), ZoneCase.Name), NumPoints, NumPoints, Iterations, []() {},
+				[Zone, Spacing, NumPoints]()
+				{
+					BenchmarkSink = Zone->GetPoissonPointsInPolyZone(Spacing, NumPoints, true).Num();
+				}));
+			Results.Add(Measure(TEXT("Sampling"), FString::Printf(TEXT("%s_Stratified"), ZoneCase.Name), NumPoints, NumPoints, Iterations, []() {},
+				[Zone, Spacing]()
+				{
+					BenchmarkSink = Zone->GetStratifiedPointsInPolyZone(Spacing, 1.0f, true).Num();
+				}));
+		}
+		Zone->Destroy();
+	}
+}
+
+APolyZone* UPolyZone_BenchmarkCommandlet::SpawnZone(UWorld* World, const TArray<FVector2D>& Polygon, bool DecomposeConcave) const
+{
+	APolyZone* Zone = World->SpawnActorDeferred<APolyZone>(APolyZone::StaticClass(), FTransform::Identity);
+	if( !Zone )
+	{
+		return nullptr;
+	}
+
+	Zone->bDecomposeConcave = DecomposeConcave;
+	Zone->MaxConvexPieces = Polygon.Num(); // Never fall back, the pieces path is what we want to time
+	#if WITH_EDITORONLY_DATA
+	Zone->ShowVisualization = false;
+	#endif
+
+	TArray<FVector> SplinePoints;
+	SplinePoints.Reserve(Polygon.Num());
+	for( const FVector2D& Point : Polygon )
+	{
+		SplinePoints.Add(FVector(Point.X, Point.Y, 0.0));
+	}
+	Zone->PolySpline->SetSplinePoints(SplinePoints, ESplineCoordinateSpace::Local, true);
+	Zone->FinishSpawning(FTransform::Identity); // Runs construction, which builds the shape
+	return Zone;
+}
+
+bool UPolyZone_BenchmarkCommandlet::WriteResults(const FString& OutputDir) const
+{
+	const TSharedPtr<IPlugin> Plugin = IPluginManager::Get().FindPlugin(TEXT("PolyZones_Plugin"));
+	const FString PluginVersion = Plugin.IsValid() ? Plugin->GetDescriptor().VersionName : TEXT("Unknown");
+	const FDateTime Now = FDateTime::UtcNow();
+	const FString BasePath = OutputDir / FString::Printf(TEXT("PolyZoneBenchmark_%s_%s"), *PluginVersion, *Now.ToString());
+
+	// -- CSV --
+	FString Csv = TEXT("Suite,Case,Size,OpsPerIteration,Iterations,MinMs,MedianMs,MaxMs,NsPerOp\n");
+	for( const FPolyZone_BenchmarkResult& Result : Results )
+	{
+		Csv += FString::Printf(TEXT("%s,%s,%d,%lld,%d,%.4f,%.4f,%.4f,%.2f\n"), *Result.Suite, *Result.Case, Result.Size, Result.OpsPerIteration, Result.Iterations,
+			Result.MinMs, Result.MedianMs, Result.MaxMs, Result.GetNsPerOp());
+	}
+
+	// -- JSON --
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetStringField(TEXT("pluginVersion"), PluginVersion);
+	Root->SetStringField(TEXT("engineVersion"), FEngineVersion::Current().ToString());
+	Root->SetStringField(TEXT("buildConfiguration"), LexToString(FApp::GetBuildConfiguration()));
+	Root->SetStringField(TEXT("timestamp"), Now.ToIso8601());
+	Root->SetNumberField(TEXT("iterations"), Iterations);
+	Root->SetNumberField(TEXT("queries"), NumQueries);
+	Root->SetNumberField(TEXT("seed"), Seed);
+
+	TArray<TSharedPtr<FJsonValue>> JsonResults;
+	for( const FPolyZone_BenchmarkResult& Result : Results )
+	{
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetStringField(TEXT("suite"), Result.Suite);
+		Entry->SetStringField(TEXT("case"), Result.Case);
+		Entry->SetNumberField(TEXT("size"), Result.Size);
+		Entry->SetNumberField(TEXT("opsPerIteration"), Result.OpsPerIteration);
+		Entry->SetNumberField(TEXT("iterations"), Result.Iterations);
+		Entry->SetNumberField(TEXT("minMs"), Result.MinMs);
+		Entry->SetNumberField(TEXT("medianMs"), Result.MedianMs);
+		Entry->SetNumberField(TEXT("maxMs"), Result.MaxMs);
+		Entry->SetNumberField(TEXT("nsPerOp"), Result.GetNsPerOp());
+		JsonResults.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+	Root->SetArrayField(TEXT("results"), JsonResults);
+
+	FString Json;
+	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	FJsonSerializer::Serialize(Root, Writer);
+
+	const FString CsvPath = BasePath + TEXT(".csv");
+	const FString JsonPath = BasePath + TEXT(".json");
+	if( !FFileHelper::SaveStringToFile(Csv, *CsvPath) || !FFileHelper::SaveStringToFile(Json, *JsonPath) )
+	{
+		UE_LOG(LogPolyZones, Error, TEXT("PolyZone benchmark could not write results to %s"), *OutputDir);
+		return false;
+	}
+
+	UE_LOG(LogPolyZones, Display, TEXT("PolyZone benchmark wrote %d results to %s"), Results.Num(), *CsvPath);
+	return true;
+}
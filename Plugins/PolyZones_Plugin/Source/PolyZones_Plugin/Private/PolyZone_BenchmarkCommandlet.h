@@ -0,0 +1,64 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "GameFramework/Actor.h"
+#include "PolyZone_Interface.h"
+#include "PolyZone_BenchmarkCommandlet.generated.h"
+
+class APolyZone;
+
+// One benchmark case, times are per iteration
+struct FPolyZone_BenchmarkResult
+{
+	FString Suite;
+	FString Case;
+	int32 Size = 0; // Vertices or actors, depending on the suite
+	int64 OpsPerIteration = 0;
+	int32 Iterations = 0;
+	double MinMs = 0.0;
+	double MedianMs = 0.0;
+	double MaxMs = 0.0;
+
+	double GetNsPerOp() const { return OpsPerIteration > 0 ? (MedianMs * 1000000.0) / OpsPerIteration : 0.0; }
+};
+
+// Minimal actor the tracking benchmark feeds to the zones
+UCLASS(Transient, NotBlueprintable, NotPlaceable)
+class APolyZone_BenchmarkActor : public AActor, public IPolyZone_Interface
+{
+	GENERATED_BODY()
+
+public:
+	APolyZone_BenchmarkActor();
+};
+
+/*Headless benchmark of the PolyZone hot paths, results are written as CSV and JSON so plugin versions can be compared
+ *
+ *UnrealEditor-Cmd ZonesProject.uproject -run=PolyZone_Benchmark -nullrhi [-Suites=Query,Build,Tracking,Sampling] [-Iterations=20] [-Queries=100000] [-Seed=47] [-Output=Dir]*/
+UCLASS()
+class UPolyZone_BenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPolyZone_BenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	void RunQuerySuite(UWorld* World);
+	void RunBuildSuite();
+	void RunTrackingSuite(UWorld* World);
+	void RunSamplingSuite(UWorld* World);
+	bool WriteResults(const FString& OutputDir) const;
+
+	APolyZone* SpawnZone(UWorld* World, const TArray<FVector2D>& Polygon, bool DecomposeConcave) const;
+
+	int32 Iterations = 20;
+	int32 NumQueries = 100000;
+	int32 Seed = 47;
+	TArray<FPolyZone_BenchmarkResult> Results;
+};
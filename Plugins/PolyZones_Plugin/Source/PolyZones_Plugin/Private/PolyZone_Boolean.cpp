@@ -0,0 +1,554 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_Boolean.h"
+#include "PolyZone.h"
+#include "PolyZone_Geometry.h"
+#include "PolyZone_Importer.h"
+#include "PolyZones_Plugin.h"
+#include "Algo/Reverse.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+namespace
+{
+	using FRings = TArray<TArray<FVector2D>>;
+	using FEdgeKey = TPair<FPolyZone_FixedPoint, FPolyZone_FixedPoint>;
+
+	constexpr double SnapTolerance = 0.5 / FPolyZone_Geometry::FixedPointScale; // Closer than this ends up on the same fixed point anyway
+	constexpr double MinRingArea = 1.0; // cm², slivers left by snapping
+
+	struct FInputEdge
+	{
+		FVector2D Start;
+		FVector2D End;
+		FBox2D Bounds;
+		TArray<double> Splits; // Where the other polygon crosses, touches or overlaps this edge (0-1 along it)
+	};
+
+	struct FSubEdge
+	{
+		FPolyZone_FixedPoint Start;
+		FPolyZone_FixedPoint End;
+	};
+
+	enum class EEdgeSide : uint8
+	{
+		Inside,
+		Outside,
+		Shared, // The other polygon has the same edge, in the same direction
+		SharedOpposite // The other polygon has the same edge, reversed (the polygons are on either side of it)
+	};
+
+	void CollectEdges(const FRings& Rings, TArray<FInputEdge>& OutEdges)
+	{
+		for( const TArray<FVector2D>& Ring : Rings )
+		{
+			for( int32 i = 0; i < Ring.Num(); ++i )
+			{
+				FInputEdge& Edge = OutEdges.AddDefaulted_GetRef();
+				Edge.Start = Ring[i];
+				Edge.End = Ring[(i + 1) % Ring.Num()];
+				Edge.Bounds = FBox2D(FVector2D::Min(Edge.Start, Edge.End), FVector2D::Max(Edge.Start, Edge.End)).ExpandBy(SnapTolerance);
+			}
+		}
+	}
+
+	void AddSplit(FInputEdge& Edge, double Alpha)
+	{
+		if( Alpha > 0.0 && Alpha < 1.0 )
+		{
+			Edge.Splits.Add(Alpha); // Splits at the ends are the ends, splitting again would add nothing
+		}
+	}
+
+	void IntersectEdges(FInputEdge& A, FInputEdge& B)
+	{
+		const FVector2D R = A.End - A.Start;
+		const FVector2D S = B.End - B.Start;
+		const double LengthA = R.Size();
+		const double LengthB = S.Size();
+		if( LengthA <= SnapTolerance || LengthB <= SnapTolerance )
+		{
+			return;
+		}
+
+		const FVector2D Delta = B.Start - A.Start;
+		const double Denominator = FVector2D::CrossProduct(R, S);
+		if( FMath::Abs(Denominator) <= SnapTolerance * FMath::Max(LengthA, LengthB) )
+		{
+			// Parallel, only a collinear overlap splits anything: each edge is split where the other one ends
+			if( FMath::Abs(FVector2D::CrossProduct(Delta, R)) > SnapTolerance * LengthA )
+			{
+				return;
+			}
+			AddSplit(A, FVector2D::DotProduct(B.Start - A.Start, R) / (LengthA * LengthA));
+			AddSplit(A, FVector2D::DotProduct(B.End - A.Start, R) / (LengthA * LengthA));
+			AddSplit(B, FVector2D::DotProduct(A.Start - B.Start, S) / (LengthB * LengthB));
+			AddSplit(B, FVector2D::DotProduct(A.End - B.Start, S) / (LengthB * LengthB));
+			return;
+		}
+
+		const double AlphaA = FVector2D::CrossProduct(Delta, S) / Denominator;
+		const double AlphaB = FVector2D::CrossProduct(Delta, R) / Denominator;
+		const double ToleranceA = SnapTolerance / LengthA;
+		const double ToleranceB = SnapTolerance / LengthB;
+		if( AlphaA >= -ToleranceA && AlphaA <= 1.0 + ToleranceA && AlphaB >= -ToleranceB && AlphaB <= 1.0 + ToleranceB )
+		{
+			AddSplit(A, AlphaA);
+			AddSplit(B, AlphaB);
+		}
+	}
+
+	// Every pair of edges whose bounds overlap, most pairs of real zone outlines are rejected by the bounds
+	void IntersectAllEdges(TArray<FInputEdge>& EdgesA, TArray<FInputEdge>& EdgesB)
+	{
+		for( FInputEdge& EdgeA : EdgesA )
+		{
+			for( FInputEdge& EdgeB : EdgesB )
+			{
+				if( EdgeA.Bounds.Intersect(EdgeB.Bounds) )
+				{
+					IntersectEdges(EdgeA, EdgeB);
+				}
+			}
+		}
+	}
+
+	void SplitEdges(TArray<FInputEdge>& Edges, TArray<FSubEdge>& OutSubEdges)
+	{
+		for( FInputEdge& Edge : Edges )
+		{
+			Edge.Splits.Sort();
+			FPolyZone_FixedPoint Previous = FPolyZone_Geometry::ToFixedPoint(Edge.Start);
+			for( int32 i = 0; i <= Edge.Splits.Num(); ++i )
+			{
+				const FVector2D Point = i < Edge.Splits.Num() ? FMath::Lerp(Edge.Start, Edge.End, Edge.Splits[i]) : Edge.End;
+				const FPolyZone_FixedPoint Next = FPolyZone_Geometry::ToFixedPoint(Point);
+				if( !(Next == Previous) ) // Splits closer than the snap merge into one vertex
+				{
+					OutSubEdges.Add({ Previous, Next });
+					Previous = Next;
+				}
+			}
+		}
+	}
+
+	bool IsPointInRing(const TArray<FVector2D>& Ring, const FVector2D& Point)
+	{
+		bool IsInside = false;
+		for( int32 i = 0, j = Ring.Num() - 1; i < Ring.Num(); j = i++ )
+		{
+			if( (Ring[i].Y > Point.Y) != (Ring[j].Y > Point.Y) &&
+				Point.X < (Ring[j].X - Ring[i].X) * (Point.Y - Ring[i].Y) / (Ring[j].Y - Ring[i].Y) + Ring[i].X )
+			{
+				IsInside = !IsInside;
+			}
+		}
+		return IsInside;
+	}
+
+	// Even-odd over every ring, so holes count as outside
+	bool IsPointInRings(const FRings& Rings, const FVector2D& Point)
+	{
+		bool IsInside = false;
+		for( const TArray<FVector2D>& Ring : Rings )
+		{
+			IsInside ^= IsPointInRing(Ring, Point);
+		}
+		return IsInside;
+	}
+
+	EEdgeSide ClassifyEdge(const FSubEdge& Edge, const TSet<FEdgeKey>& OtherEdges, const FRings& OtherRings)
+	{
+		if( OtherEdges.Contains(FEdgeKey(Edge.Start, Edge.End)) )
+		{
+			return EEdgeSide::Shared;
+		}
+		if( OtherEdges.Contains(FEdgeKey(Edge.End, Edge.Start)) )
+		{
+			return EEdgeSide::SharedOpposite;
+		}
+
+		// After splitting an edge is entirely on one side, its midpoint decides for all of it
+		const FVector2D Midpoint = (FPolyZone_Geometry::FromFixedPoint(Edge.Start) + FPolyZone_Geometry::FromFixedPoint(Edge.End)) * 0.5;
+		return IsPointInRings(OtherRings, Midpoint) ? EEdgeSide::Inside : EEdgeSide::Outside;
+	}
+
+	// Drops vertices on a straight line (left behind by overlap splits) and spikes
+	void RemoveCollinear(TArray<FPolyZone_FixedPoint>& Ring)
+	{
+		bool Removed = true;
+		while( Removed && Ring.Num() >= 3 )
+		{
+			Removed = false;
+			for( int32 i = 0; i < Ring.Num() && Ring.Num() >= 3; ++i )
+			{
+				const FPolyZone_FixedPoint& Previous = Ring[(i + Ring.Num() - 1) % Ring.Num()];
+				const FPolyZone_FixedPoint& Next = Ring[(i + 1) % Ring.Num()];
+				if( Previous == Ring[i] || FPolyZone_Geometry::Orientation_Fixed(Previous, Ring[i], Next) == 0 )
+				{
+					Ring.RemoveAt(i--, 1, false);
+					Removed = true;
+				}
+			}
+		}
+	}
+
+	// Links the kept edges end to start, where several edges leave one vertex the sharpest left turn keeps the area on the left in one ring
+	void StitchRings(const TArray<FSubEdge>& Edges, FRings& OutRings)
+	{
+		TMultiMap<FPolyZone_FixedPoint, int32> Outgoing;
+		for( int32 i = 0; i < Edges.Num(); ++i )
+		{
+			Outgoing.Add(Edges[i].Start, i);
+		}
+
+		TBitArray<> Used(false, Edges.Num());
+		TArray<int32> Candidates;
+		TArray<FPolyZone_FixedPoint> Ring;
+		for( int32 First = 0; First < Edges.Num(); ++First )
+		{
+			if( Used[First] )
+			{
+				continue;
+			}
+
+			Ring.Reset();
+			int32 Current = First;
+			Used[First] = true;
+			bool Closed = false;
+			while( true )
+			{
+				Ring.Add(Edges[Current].Start);
+				if( Edges[Current].End == Edges[First].Start )
+				{
+					Closed = true;
+					break;
+				}
+
+				Candidates.Reset();
+				Outgoing.MultiFind(Edges[Current].End, Candidates);
+				const FVector2D Incoming = FPolyZone_Geometry::FromFixedPoint(Edges[Current].End) - FPolyZone_Geometry::FromFixedPoint(Edges[Current].Start);
+				int32 Best = INDEX_NONE;
+				double BestTurn = -DOUBLE_BIG_NUMBER;
+				for( const int32 Candidate : Candidates )
+				{
+					if( Used[Candidate] || Edges[Candidate].End == Edges[Current].Start )
+					{
+						continue; // Never turn straight back
+					}
+					const FVector2D Out = FPolyZone_Geometry::FromFixedPoint(Edges[Candidate].End) - FPolyZone_Geometry::FromFixedPoint(Edges[Candidate].Start);
+					const double Turn = FMath::Atan2(FVector2D::CrossProduct(Incoming, Out), FVector2D::DotProduct(Incoming, Out));
+					if( Turn > BestTurn )
+					{
+						BestTurn = Turn;
+						Best = Candidate;
+					}
+				}
+				if( Best == INDEX_NONE )
+				{
+					break;
+				}
+				Used[Best] = true;
+				Current = Best;
+			}
+
+			if( !Closed )
+			{
+				UE_LOG(LogPolyZones, Verbose, TEXT("PolyZone boolean dropped an open chain of %d edges"), Ring.Num());
+				continue;
+			}
+
+			RemoveCollinear(Ring);
+			TArray<FVector2D> Points;
+			Points.Reserve(Ring.Num());
+			for( const FPolyZone_FixedPoint& Point : Ring )
+			{
+				Points.Add(FPolyZone_Geometry::FromFixedPoint(Point));
+			}
+			if( Points.Num() >= 3 && FMath::Abs(FPolyZone_Geometry::SignedArea(Points)) >= MinRingArea )
+			{
+				OutRings.Add(MoveTemp(Points));
+			}
+		}
+	}
+
+	bool IsProperlyBlocked(const FVector2D& From, const FVector2D& To, const TArray<FVector2D>& Ring)
+	{
+		for( int32 i = 0; i < Ring.Num(); ++i )
+		{
+			const FVector2D& Start = Ring[i];
+			const FVector2D& End = Ring[(i + 1) % Ring.Num()];
+			if( Start.Equals(From) || End.Equals(From) || Start.Equals(To) || End.Equals(To) )
+			{
+				continue; // Edges at the bridge ends only touch it
+			}
+			if( FPolyZone_Geometry::SegmentsIntersect2D(From, To, Start, End) )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Splices a hole into its outer ring through the closest outer vertex that can see the hole's rightmost vertex
+	bool BridgeHole(TArray<FVector2D>& Outline, const TArray<FVector2D>& Hole, const TArray<const TArray<FVector2D>*>& OtherHoles)
+	{
+		int32 HoleIndex = 0;
+		for( int32 i = 1; i < Hole.Num(); ++i )
+		{
+			HoleIndex = Hole[i].X > Hole[HoleIndex].X ? i : HoleIndex;
+		}
+		const FVector2D& HolePoint = Hole[HoleIndex];
+
+		TArray<int32> Order;
+		Order.Reserve(Outline.Num());
+		for( int32 i = 0; i < Outline.Num(); ++i )
+		{
+			Order.Add(i);
+		}
+		Order.Sort([&Outline, &HolePoint](int32 A, int32 B) { return FVector2D::DistSquared(Outline[A], HolePoint) < FVector2D::DistSquared(Outline[B], HolePoint); });
+
+		for( const int32 OutlineIndex : Order )
+		{
+			const FVector2D& OutlinePoint = Outline[OutlineIndex];
+			bool Blocked = IsProperlyBlocked(OutlinePoint, HolePoint, Outline) || IsProperlyBlocked(OutlinePoint, HolePoint, Hole);
+			for( int32 i = 0; i < OtherHoles.Num() && !Blocked; ++i )
+			{
+				Blocked = IsProperlyBlocked(OutlinePoint, HolePoint, *OtherHoles[i]);
+			}
+			if( Blocked )
+			{
+				continue;
+			}
+
+			// Outer vertex, around the hole back to its first vertex, then the outer vertex again
+			TArray<FVector2D> Bridged;
+			Bridged.Reserve(Outline.Num() + Hole.Num() + 2);
+			Bridged.Append(Outline.GetData(), OutlineIndex + 1);
+			for( int32 i = 0; i <= Hole.Num(); ++i )
+			{
+				Bridged.Add(Hole[(HoleIndex + i) % Hole.Num()]);
+			}
+			Bridged.Append(Outline.GetData() + OutlineIndex, Outline.Num() - OutlineIndex);
+			Outline = MoveTemp(Bridged);
+			return true;
+		}
+		return false;
+	}
+
+	// World XY of the zone's outline relative to Origin, the fixed point grid only reaches FixedPointMaxCoord from 0
+	FRings GetWorldRings(const APolyZone* Zone, const FVector2D& Origin)
+	{
+		FRings Rings;
+		if( const FPolyZone_ShapePtr Shape = Zone->GetShape() )
+		{
+			TArray<FVector2D>& Ring = Rings.AddDefaulted_GetRef();
+			Ring.Reserve(Shape->Polygon.Num());
+			for( const FVector2D& LocalPoint : Shape->Polygon )
+			{
+				const FVector WorldPoint = Zone->GetZoneFrame().ToWorld(LocalPoint, 0.0);
+				Ring.Add(FVector2D(WorldPoint.X, WorldPoint.Y) - Origin);
+			}
+		}
+		return Rings;
+	}
+}
+
+void FPolyZone_Boolean::Compute(const TArray<TArray<FVector2D>>& A, const TArray<TArray<FVector2D>>& B, POLYZONE_BOOLEAN_OP Operation, TArray<TArray<FVector2D>>& OutRings)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPolyZone_Boolean::Compute);
+	OutRings.Reset();
+
+	// Every edge needs the area on its left for the rules below
+	FRings RingsA = A;
+	FRings RingsB = B;
+	for( FRings* Rings : { &RingsA, &RingsB } )
+	{
+		Rings->RemoveAll([](const TArray<FVector2D>& Ring) { return Ring.Num() < 3; });
+		if( Rings->Num() == 1 && FPolyZone_Geometry::SignedArea((*Rings)[0]) < 0.0 )
+		{
+			Algo::Reverse((*Rings)[0]);
+		}
+	}
+
+	TArray<FInputEdge> InputEdgesA, InputEdgesB;
+	CollectEdges(RingsA, InputEdgesA);
+	CollectEdges(RingsB, InputEdgesB);
+	IntersectAllEdges(InputEdgesA, InputEdgesB);
+
+	TArray<FSubEdge> EdgesA, EdgesB;
+	SplitEdges(InputEdgesA, EdgesA);
+	SplitEdges(InputEdgesB, EdgesB);
+
+	TSet<FEdgeKey> KeysA, KeysB;
+	KeysA.Reserve(EdgesA.Num());
+	KeysB.Reserve(EdgesB.Num());
+	for( const FSubEdge& Edge : EdgesA ) KeysA.Add(FEdgeKey(Edge.Start, Edge.End));
+	for( const FSubEdge& Edge : EdgesB ) KeysB.Add(FEdgeKey(Edge.Start, Edge.End));
+
+	// Shared edges are only ever kept from A, so they aren't added twice
+	TArray<FSubEdge> Kept;
+	for( const FSubEdge& Edge : EdgesA )
+	{
+		const EEdgeSide Side = ClassifyEdge(Edge, KeysB, RingsB);
+		const bool Keep =
+			(Operation == POLYZONE_BOOLEAN_OP::Union && (Side == EEdgeSide::Outside || Side == EEdgeSide::Shared)) ||
+			(Operation == POLYZONE_BOOLEAN_OP::Intersection && (Side == EEdgeSide::Inside || Side == EEdgeSide::Shared)) ||
+			(Operation == POLYZONE_BOOLEAN_OP::Difference && (Side == EEdgeSide::Outside || Side == EEdgeSide::SharedOpposite));
+		if( Keep )
+		{
+			Kept.Add(Edge);
+		}
+	}
+	for( const FSubEdge& Edge : EdgesB )
+	{
+		const EEdgeSide Side = ClassifyEdge(Edge, KeysA, RingsA);
+		if( Operation == POLYZONE_BOOLEAN_OP::Union && Side == EEdgeSide::Outside )
+		{
+			Kept.Add(Edge);
+		}
+		else if( Operation == POLYZONE_BOOLEAN_OP::Intersection && Side == EEdgeSide::Inside )
+		{
+			Kept.Add(Edge);
+		}
+		else if( Operation == POLYZONE_BOOLEAN_OP::Difference && Side == EEdgeSide::Inside )
+		{
+			Kept.Add({ Edge.End, Edge.Start }); // B's edges become the border of A's remaining area, which is on their other side
+		}
+	}
+
+	StitchRings(Kept, OutRings);
+}
+
+void FPolyZone_Boolean::MakeOutlines(const TArray<TArray<FVector2D>>& Rings, TArray<TArray<FVector2D>>& OutOutlines)
+{
+	OutOutlines.Reset();
+
+	TArray<int32> Outers, Holes;
+	TArray<double> Areas;
+	for( int32 i = 0; i < Rings.Num(); ++i )
+	{
+		Areas.Add(FPolyZone_Geometry::SignedArea(Rings[i]));
+		(Areas[i] > 0.0 ? Outers : Holes).Add(i);
+	}
+
+	// Every hole goes to the smallest outer ring around it
+	TMultiMap<int32, int32> HolesOfOuter;
+	for( const int32 Hole : Holes )
+	{
+		int32 BestOuter = INDEX_NONE;
+		for( const int32 Outer : Outers )
+		{
+			if( IsPointInRing(Rings[Outer], Rings[Hole][0]) && (BestOuter == INDEX_NONE || Areas[Outer] < Areas[BestOuter]) )
+			{
+				BestOuter = Outer;
+			}
+		}
+		if( BestOuter != INDEX_NONE )
+		{
+			HolesOfOuter.Add(BestOuter, Hole);
+		}
+	}
+
+	TArray<int32> OuterHoles;
+	TArray<const TArray<FVector2D>*> OtherHoles;
+	for( const int32 Outer : Outers )
+	{
+		TArray<FVector2D> Outline = Rings[Outer];
+
+		// Rightmost holes first, so bridges of later holes can't cross the earlier ones unseen
+		OuterHoles.Reset();
+		HolesOfOuter.MultiFind(Outer, OuterHoles);
+		auto MaxX = [&Rings](int32 Ring) { double Max = -DOUBLE_BIG_NUMBER; for( const FVector2D& Point : Rings[Ring] ) { Max = FMath::Max(Max, Point.X); } return Max; };
+		OuterHoles.Sort([&MaxX](int32 A, int32 B) { return MaxX(A) > MaxX(B); });
+
+		for( int32 i = 0; i < OuterHoles.Num(); ++i )
+		{
+			OtherHoles.Reset();
+			for( int32 j = i + 1; j < OuterHoles.Num(); ++j )
+			{
+				OtherHoles.Add(&Rings[OuterHoles[j]]);
+			}
+			if( !BridgeHole(Outline, Rings[OuterHoles[i]], OtherHoles) )
+			{
+				UE_LOG(LogPolyZones, Warning, TEXT("PolyZone boolean could not join a hole to its outline, the hole is left out"));
+			}
+		}
+		OutOutlines.Add(MoveTemp(Outline));
+	}
+}
+
+TArray<APolyZone*> UPolyZone_BooleanLibrary::CombinePolyZones(const UObject* WorldContextObject, const TArray<APolyZone*>& Zones, POLYZONE_BOOLEAN_OP Operation, TSubclassOf<APolyZone> ZoneClass)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPolyZone_BooleanLibrary::CombinePolyZones);
+
+	TArray<APolyZone*> SpawnedZones;
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	if( !World )
+	{
+		return SpawnedZones;
+	}
+
+	FRings Result;
+	FFloatInterval HeightRange;
+	FVector2D Origin = FVector2D::ZeroVector; // Center of the first zone, every ring is relative to it while combining
+	bool First = true;
+	for( const APolyZone* Zone : Zones )
+	{
+		if( !IsValid(Zone) || !Zone->GetShape().IsValid() )
+		{
+			continue;
+		}
+
+		const float Bottom = Zone->GetZoneFrame().Origin.Z;
+		const FFloatInterval ZoneRange(Bottom, Bottom + Zone->ZoneHeight);
+		if( First )
+		{
+			const FPolyZone_ShapePtr Shape = Zone->GetShape();
+			const FVector BoundsCenter = Zone->GetZoneFrame().ToWorld((Shape->BoundsMin + Shape->BoundsMax) * 0.5, 0.0);
+			Origin = FVector2D(BoundsCenter.X, BoundsCenter.Y);
+			Result = GetWorldRings(Zone, Origin);
+			HeightRange = ZoneRange;
+			First = false;
+			continue;
+		}
+
+		FRings Combined;
+		FPolyZone_Boolean::Compute(Result, GetWorldRings(Zone, Origin), Operation, Combined);
+		Result = MoveTemp(Combined);
+		if( Operation == POLYZONE_BOOLEAN_OP::Union )
+		{
+			HeightRange.Include(ZoneRange.Min);
+			HeightRange.Include(ZoneRange.Max);
+		}
+		else if( Operation == POLYZONE_BOOLEAN_OP::Intersection )
+		{
+			HeightRange = FFloatInterval(FMath::Max(HeightRange.Min, ZoneRange.Min), FMath::Min(HeightRange.Max, ZoneRange.Max));
+		}
+	}
+	if( HeightRange.Size() <= 0.0f )
+	{
+		return SpawnedZones; // Intersection of zones that don't share any height
+	}
+
+	TArray<TArray<FVector2D>> Outlines;
+	FPolyZone_Boolean::MakeOutlines(Result, Outlines);
+	for( const TArray<FVector2D>& Outline : Outlines )
+	{
+		const FVector2D Center = FBox2D(Outline).GetCenter();
+		TArray<FVector2D> LocalOutline;
+		LocalOutline.Reserve(Outline.Num());
+		for( const FVector2D& Point : Outline )
+		{
+			LocalOutline.Add(Point - Center);
+		}
+
+		const FVector2D WorldCenter = Origin + Center;
+		if( APolyZone* Zone = FPolyZone_Importer::SpawnZone(World, ZoneClass, NAME_None, FVector(WorldCenter.X, WorldCenter.Y, HeightRange.Min), HeightRange.Size(), LocalOutline) )
+		{
+			SpawnedZones.Add(Zone);
+		}
+	}
+	return SpawnedZones;
+}
@@ -0,0 +1,489 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_Geometry.h"
+
+namespace
+{
+	// Double precision turn direction of A -> B -> C, > 0 turns left
+	FORCEINLINE double Turn2D(const FVector2D& A, const FVector2D& B, const FVector2D& C)
+	{
+		return (B.X - A.X) * (C.Y - A.Y) - (B.Y - A.Y) * (C.X - A.X);
+	}
+
+	FORCEINLINE bool IsOnSegment_Fixed(const FPolyZone_FixedPoint& A, const FPolyZone_FixedPoint& B, const FPolyZone_FixedPoint& P)
+	{
+		return P.X >= FMath::Min(A.X, B.X) && P.X <= FMath::Max(A.X, B.X) &&
+			P.Y >= FMath::Min(A.Y, B.Y) && P.Y <= FMath::Max(A.Y, B.Y);
+	}
+}
+
+double FPolyZone_Geometry::SignedArea(const TArray<FVector2D>& Polygon)
+{
+	double DoubleArea = 0.0;
+	const int32 NumPoints = Polygon.Num();
+	for( int32 i = 0, j = NumPoints - 1; i < NumPoints; j = i++ )
+	{
+		DoubleArea += (Polygon[j].X * Polygon[i].Y) - (Polygon[i].X * Polygon[j].Y);
+	}
+	return DoubleArea * 0.5;
+}
+
+bool FPolyZone_Geometry::IsPointInAABB_2D(const FVector2D& Point, const FVector2D& Min, const FVector2D& Max)
+{
+	return Point.X >= Min.X && Point.X <= Max.X && Point.Y >= Min.Y && Point.Y <= Max.Y;
+}
+
+double FPolyZone_Geometry::Cross2D(const FVector2D& A, const FVector2D& B, const FVector2D& C)
+{
+	return (B.X - A.X) * (C.Y - A.Y) - (B.Y - A.Y) * (C.X - A.X);
+}
+
+bool FPolyZone_Geometry::IsOnSegment2D(const FVector2D& A, const FVector2D& B, const FVector2D& P)
+{
+	return P.X >= FMath::Min(A.X, B.X) && P.X <= FMath::Max(A.X, B.X) &&
+		P.Y >= FMath::Min(A.Y, B.Y) && P.Y <= FMath::Max(A.Y, B.Y);
+}
+
+bool FPolyZone_Geometry::SegmentsIntersect2D(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D)
+{
+	const double AB_C = Cross2D(A, B, C);
+	const double AB_D = Cross2D(A, B, D);
+	const double CD_A = Cross2D(C, D, A);
+	const double CD_B = Cross2D(C, D, B);
+
+	if( (AB_C == 0.0 && IsOnSegment2D(A, B, C)) || (AB_D == 0.0 && IsOnSegment2D(A, B, D)) ||
+		(CD_A == 0.0 && IsOnSegment2D(C, D, A)) || (CD_B == 0.0 && IsOnSegment2D(C, D, B)) )
+	{
+		return true;
+	}
+
+	return (AB_C > 0.0) != (AB_D > 0.0) && (CD_A > 0.0) != (CD_B > 0.0);
+}
+
+// Visvalingam-Whyatt style simplification, with the error measured against the original polygon so it can never drift past Tolerance
+int32 FPolyZone_Geometry::SimplifyPolygon(TArray<FVector2D>& Polygon, POLYZONE_SIMPLIFY_MODE Mode, double Tolerance)
+{
+	const int32 NumPoints = Polygon.Num();
+	if( Mode == POLYZONE_SIMPLIFY_MODE::None || NumPoints <= 3 || Tolerance <= 0.0 )
+	{
+		return 0;
+	}
+
+	const double Orientation = SignedArea(Polygon) >= 0.0 ? 1.0 : -1.0;
+
+	TArray<int32> Prev, Next, Versions;
+	TArray<bool> Removed;
+	Prev.SetNumUninitialized(NumPoints);
+	Next.SetNumUninitialized(NumPoints);
+	Versions.Init(0, NumPoints);
+	Removed.Init(false, NumPoints);
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		Prev[i] = (i + NumPoints - 1) % NumPoints;
+		Next[i] = (i + 1) % NumPoints;
+	}
+
+	struct FCandidate
+	{
+		double Cost;
+		int32 Index;
+		int32 Version;
+	};
+	TArray<FCandidate> Heap;
+	Heap.Reserve(NumPoints);
+	auto CheapestFirst = [](const FCandidate& A, const FCandidate& B) { return A.Cost < B.Cost; };
+
+	// Pushes the vertex if removing it is allowed by the mode and tolerance
+	auto TryPushCandidate = [&](int32 Index)
+	{
+		const FVector2D& A = Polygon[Prev[Index]];
+		const FVector2D& B = Polygon[Index];
+		const FVector2D& C = Polygon[Next[Index]];
+		const double Turn = Turn2D(A, B, C) * Orientation; // > 0 convex, < 0 reflex
+
+		// Removing a convex vertex cuts a triangle off the polygon, removing a reflex vertex adds one
+		if( Mode == POLYZONE_SIMPLIFY_MODE::Outer && Turn > 0.0 ) return;
+		if( Mode == POLYZONE_SIMPLIFY_MODE::Inner && Turn < 0.0 ) return;
+
+		// Every original vertex between our neighbours must stay within tolerance of the new edge
+		for( int32 Span = (Prev[Index] + 1) % NumPoints; Span != Next[Index]; Span = (Span + 1) % NumPoints )
+		{
+			const FVector2D ClosestPoint = FMath::ClosestPointOnSegment2D(Polygon[Span], A, C);
+			if( FVector2D::DistSquared(ClosestPoint, Polygon[Span]) > Tolerance * Tolerance )
+			{
+				return;
+			}
+		}
+
+		Heap.HeapPush({ FMath::Abs(Turn) * 0.5, Index, Versions[Index] }, CheapestFirst);
+	};
+
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		TryPushCandidate(i);
+	}
+
+	int32 RemainingPoints = NumPoints;
+	while( Heap.Num() > 0 && RemainingPoints > 3 )
+	{
+		FCandidate Candidate;
+		Heap.HeapPop(Candidate, CheapestFirst);
+		if( Removed[Candidate.Index] || Candidate.Version != Versions[Candidate.Index] )
+		{
+			continue; // Stale, a neighbour was removed after this was pushed
+		}
+
+		// The new edge must not cross any other edge of the polygon
+		const int32 A = Prev[Candidate.Index];
+		const int32 C = Next[Candidate.Index];
+		bool CreatesIntersection = false;
+		for( int32 Edge = Next[C]; Next[Edge] != A; Edge = Next[Edge] )
+		{
+			if( SegmentsIntersect2D(Polygon[A], Polygon[C], Polygon[Edge], Polygon[Next[Edge]]) )
+			{
+				CreatesIntersection = true;
+				break;
+			}
+		}
+		if( CreatesIntersection )
+		{
+			continue; // It will be reconsidered if one of its neighbours changes
+		}
+
+		Removed[Candidate.Index] = true;
+		Next[A] = C;
+		Prev[C] = A;
+		RemainingPoints--;
+
+		++Versions[A];
+		++Versions[C];
+		TryPushCandidate(A);
+		TryPushCandidate(C);
+	}
+
+	const int32 NumRemoved = NumPoints - RemainingPoints;
+	if( NumRemoved > 0 )
+	{
+		TArray<FVector2D> Simplified;
+		Simplified.Reserve(RemainingPoints);
+		for( int32 i = 0; i < NumPoints; ++i )
+		{
+			if( !Removed[i] )
+			{
+				Simplified.Add(Polygon[i]);
+			}
+		}
+		Polygon = MoveTemp(Simplified);
+	}
+	return NumRemoved;
+}
+
+bool FPolyZone_Geometry::IsConvex(const TArray<FVector2D>& Polygon)
+{
+	const int32 NumPoints = Polygon.Num();
+	if( NumPoints < 3 )
+	{
+		return false;
+	}
+
+	double Orientation = 0.0;
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		const double Turn = Turn2D(Polygon[i], Polygon[(i + 1) % NumPoints], Polygon[(i + 2) % NumPoints]);
+		if( Turn == 0.0 )
+		{
+			continue;
+		}
+		if( Orientation == 0.0 )
+		{
+			Orientation = Turn;
+		}
+		else if( (Turn > 0.0) != (Orientation > 0.0) )
+		{
+			return false;
+		}
+	}
+
+	// Same turn direction everywhere can still wind around more than once (star shapes), the total turning angle catches that
+	double TotalAngle = 0.0;
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		const FVector2D EdgeA = Polygon[(i + 1) % NumPoints] - Polygon[i];
+		const FVector2D EdgeB = Polygon[(i + 2) % NumPoints] - Polygon[(i + 1) % NumPoints];
+		TotalAngle += FMath::Atan2(EdgeA.X * EdgeB.Y - EdgeA.Y * EdgeB.X, EdgeA.X * EdgeB.X + EdgeA.Y * EdgeB.Y);
+	}
+	return Orientation != 0.0 && FMath::Abs(TotalAngle) < 2.5 * PI;
+}
+
+bool FPolyZone_Geometry::IsPointInConvexPolygon(const TArray<FVector2D>& Polygon, const FVector2D& Point)
+{
+	const int32 NumPoints = Polygon.Num();
+	if( NumPoints < 3 )
+	{
+		return false;
+	}
+
+	// Outside the wedge formed by the first vertex and its two neighbours
+	const FVector2D& Origin = Polygon[0];
+	if( Turn2D(Origin, Polygon[1], Point) < 0.0 || Turn2D(Origin, Polygon[NumPoints - 1], Point) > 0.0 )
+	{
+		return false;
+	}
+
+	// Binary search for the triangle fan slice containing the point
+	int32 Low = 1;
+	int32 High = NumPoints - 1;
+	while( High - Low > 1 )
+	{
+		const int32 Mid = (Low + High) / 2;
+		if( Turn2D(Origin, Polygon[Mid], Point) >= 0.0 )
+		{
+			Low = Mid;
+		}
+		else
+		{
+			High = Mid;
+		}
+	}
+
+	return Turn2D(Polygon[Low], Polygon[Low + 1], Point) >= 0.0;
+}
+
+bool FPolyZone_Geometry::DecomposeConvex(const TArray<FVector2D>& Polygon, TArray<FPolyZone_ConvexPiece>& OutPieces)
+{
+	OutPieces.Reset();
+	const int32 NumPoints = Polygon.Num();
+	if( NumPoints < 3 )
+	{
+		return false;
+	}
+
+	// Work on counter-clockwise indices
+	TArray<int32> Remaining;
+	Remaining.Reserve(NumPoints);
+	const bool IsClockwise = SignedArea(Polygon) < 0.0;
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		Remaining.Add(IsClockwise ? NumPoints - 1 - i : i);
+	}
+
+	// -- Ear clipping --
+	TArray<TArray<int32>> Pieces;
+	Pieces.Reserve(NumPoints - 2);
+	int32 Guard = 0;
+	int32 Current = 0;
+	while( Remaining.Num() > 3 )
+	{
+		if( Guard++ > Remaining.Num() )
+		{
+			return false; // No ear found in a full loop, the polygon is not simple
+		}
+
+		const int32 Count = Remaining.Num();
+		const int32 PrevIndex = Remaining[(Current + Count - 1) % Count];
+		const int32 EarIndex = Remaining[Current % Count];
+		const int32 NextIndex = Remaining[(Current + 1) % Count];
+		const FVector2D& A = Polygon[PrevIndex];
+		const FVector2D& B = Polygon[EarIndex];
+		const FVector2D& C = Polygon[NextIndex];
+
+		const double Turn = Turn2D(A, B, C);
+		bool IsEar = Turn >= 0.0;
+		if( IsEar && Turn > 0.0 )
+		{
+			for( const int32 Other : Remaining )
+			{
+				if( Other == PrevIndex || Other == EarIndex || Other == NextIndex )
+				{
+					continue;
+				}
+				const FVector2D& P = Polygon[Other];
+				if( Turn2D(A, B, P) >= 0.0 && Turn2D(B, C, P) >= 0.0 && Turn2D(C, A, P) >= 0.0 )
+				{
+					IsEar = false;
+					break;
+				}
+			}
+		}
+
+		if( IsEar )
+		{
+			if( Turn > 0.0 ) // Collinear points are clipped without adding a sliver
+			{
+				Pieces.Add({ PrevIndex, EarIndex, NextIndex });
+			}
+			Remaining.RemoveAt(Current % Count);
+			Current = Current % Remaining.Num();
+			Guard = 0;
+		}
+		else
+		{
+			Current = (Current + 1) % Count;
+		}
+	}
+	Pieces.Add(Remaining);
+
+	// -- Merge neighbouring pieces while they stay convex (Hertel-Mehlhorn) --
+	auto EdgeKey = [](int32 From, int32 To) { return (static_cast<uint64>(From) << 32) | static_cast<uint32>(To); };
+	TMap<uint64, int32> EdgeOwners; // Directed edge -> piece
+	for( int32 PieceIndex = 0; PieceIndex < Pieces.Num(); ++PieceIndex )
+	{
+		const TArray<int32>& Piece = Pieces[PieceIndex];
+		for( int32 i = 0; i < Piece.Num(); ++i )
+		{
+			EdgeOwners.Add(EdgeKey(Piece[i], Piece[(i + 1) % Piece.Num()]), PieceIndex);
+		}
+	}
+
+	TArray<FVector2D> MergedPoints;
+	for( int32 PieceIndex = 0; PieceIndex < Pieces.Num(); ++PieceIndex )
+	{
+		bool Merged = true;
+		while( Merged && Pieces[PieceIndex].Num() > 0 )
+		{
+			Merged = false;
+			TArray<int32>& Piece = Pieces[PieceIndex];
+			for( int32 i = 0; i < Piece.Num(); ++i )
+			{
+				const int32 From = Piece[i];
+				const int32 To = Piece[(i + 1) % Piece.Num()];
+				const int32* OtherIndex = EdgeOwners.Find(EdgeKey(To, From));
+				if( !OtherIndex || *OtherIndex == PieceIndex )
+				{
+					continue; // Outer edge of the polygon
+				}
+
+				// Walk our piece from To around to From, then the other piece from From around to To
+				const TArray<int32>& Other = Pieces[*OtherIndex];
+				TArray<int32> Combined;
+				Combined.Reserve(Piece.Num() + Other.Num() - 2);
+				for( int32 Step = 0; Step < Piece.Num(); ++Step )
+				{
+					Combined.Add(Piece[(i + 1 + Step) % Piece.Num()]);
+				}
+				const int32 OtherStart = Other.Find(From);
+				for( int32 Step = 1; Step < Other.Num() - 1; ++Step )
+				{
+					Combined.Add(Other[(OtherStart + Step) % Other.Num()]);
+				}
+
+				MergedPoints.Reset(Combined.Num());
+				for( const int32 Index : Combined )
+				{
+					MergedPoints.Add(Polygon[Index]);
+				}
+				if( !IsConvex(MergedPoints) )
+				{
+					continue;
+				}
+
+				const int32 OtherPieceIndex = *OtherIndex;
+				EdgeOwners.Remove(EdgeKey(From, To));
+				EdgeOwners.Remove(EdgeKey(To, From));
+				for( int32 Step = 0; Step < Pieces[OtherPieceIndex].Num(); ++Step )
+				{
+					const uint64 Key = EdgeKey(Pieces[OtherPieceIndex][Step], Pieces[OtherPieceIndex][(Step + 1) % Pieces[OtherPieceIndex].Num()]);
+					if( int32* Owner = EdgeOwners.Find(Key) )
+					{
+						*Owner = PieceIndex;
+					}
+				}
+				Pieces[OtherPieceIndex].Reset();
+				Pieces[PieceIndex] = MoveTemp(Combined);
+				Merged = true;
+				break;
+			}
+		}
+	}
+
+	for( const TArray<int32>& Piece : Pieces )
+	{
+		if( Piece.Num() < 3 )
+		{
+			continue; // Merged into another piece
+		}
+
+		FPolyZone_ConvexPiece& NewPiece = OutPieces.AddDefaulted_GetRef();
+		NewPiece.Points.Reserve(Piece.Num());
+		NewPiece.Min = Polygon[Piece[0]];
+		NewPiece.Max = Polygon[Piece[0]];
+		for( const int32 Index : Piece )
+		{
+			NewPiece.Points.Add(Polygon[Index]);
+			NewPiece.Min = FVector2D::Min(NewPiece.Min, Polygon[Index]);
+			NewPiece.Max = FVector2D::Max(NewPiece.Max, Polygon[Index]);
+		}
+	}
+	return OutPieces.Num() > 0;
+}
+
+// ==================== FIXED POINT ====================
+
+FPolyZone_FixedPoint FPolyZone_Geometry::ToFixedPoint(const FVector2D& Point)
+{
+	// Scaling by a power of two is exact, so only the rounding can move a point and it rounds the same way everywhere
+	constexpr double Limit = static_cast<double>(int64(1) << 40);
+	FPolyZone_FixedPoint FixedPoint;
+	FixedPoint.X = FMath::RoundToInt64(FMath::Clamp(Point.X * FixedPointScale, -Limit, Limit));
+	FixedPoint.Y = FMath::RoundToInt64(FMath::Clamp(Point.Y * FixedPointScale, -Limit, Limit));
+	return FixedPoint;
+}
+
+FVector2D FPolyZone_Geometry::FromFixedPoint(const FPolyZone_FixedPoint& Point)
+{
+	return FVector2D(Point.X / FixedPointScale, Point.Y / FixedPointScale);
+}
+
+int64 FPolyZone_Geometry::Orientation_Fixed(const FPolyZone_FixedPoint& A, const FPolyZone_FixedPoint& B, const FPolyZone_FixedPoint& C)
+{
+	return (B.X - A.X) * (C.Y - A.Y) - (B.Y - A.Y) * (C.X - A.X);
+}
+
+bool FPolyZone_Geometry::SegmentsIntersect_Fixed(const FPolyZone_FixedPoint& A, const FPolyZone_FixedPoint& B, const FPolyZone_FixedPoint& C, const FPolyZone_FixedPoint& D)
+{
+	const int64 AB_C = Orientation_Fixed(A, B, C);
+	const int64 AB_D = Orientation_Fixed(A, B, D);
+	const int64 CD_A = Orientation_Fixed(C, D, A);
+	const int64 CD_B = Orientation_Fixed(C, D, B);
+
+	if( (AB_C == 0 && IsOnSegment_Fixed(A, B, C)) || (AB_D == 0 && IsOnSegment_Fixed(A, B, D)) ||
+		(CD_A == 0 && IsOnSegment_Fixed(C, D, A)) || (CD_B == 0 && IsOnSegment_Fixed(C, D, B)) )
+	{
+		return true;
+	}
+
+	return (AB_C > 0) != (AB_D > 0) && (CD_A > 0) != (CD_B > 0);
+}
+
+bool FPolyZone_Geometry::IsPointInPolygon_Fixed(const TArray<FPolyZone_FixedPoint>& Polygon, const FPolyZone_FixedPoint& Point)
+{
+	bool Inside = false;
+	const int32 NumPoints = Polygon.Num();
+	for( int32 i = 0, j = NumPoints - 1; i < NumPoints; j = i++ )
+	{
+		const FPolyZone_FixedPoint& A = Polygon[j];
+		const FPolyZone_FixedPoint& B = Polygon[i];
+		if( B == Point )
+		{
+			return true; // On a vertex, the half open crossing rule below can miss these
+		}
+
+		if( (A.Y > Point.Y) != (B.Y > Point.Y) )
+		{
+			const int64 Turn = Orientation_Fixed(A, B, Point);
+			if( Turn == 0 )
+			{
+				return true; // On the edge
+			}
+			if( (Turn > 0) == (B.Y > A.Y) )
+			{
+				Inside = !Inside; // The ray towards +X crosses this edge
+			}
+		}
+		else if( A.Y == Point.Y && B.Y == Point.Y && IsOnSegment_Fixed(A, B, Point) )
+		{
+			return true; // On a horizontal edge
+		}
+	}
+	return Inside;
+}
@@ -0,0 +1,325 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_GridSearch.h"
+#include "PolyZone_Shape.h"
+#include "Algo/Reverse.h"
+
+namespace
+{
+	const FIntPoint CardinalSteps[] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1} };
+	const FIntPoint DiagonalSteps[] = { {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+
+	bool IsInGrid(const FPolyZone_Shape& Shape, int32 X, int32 Y)
+	{
+		return X >= 0 && Y >= 0 && X < Shape.GridCellsX && Y < Shape.GridCellsY;
+	}
+}
+
+bool FPolyZone_GridSearch::IsWalkable(const FPolyZone_Shape& Shape, int32 CellIndex, bool AllowEdgeCells)
+{
+	if( !Shape.GridData.IsValidIndex(CellIndex) )
+	{
+		return false;
+	}
+	const POLYZONE_CELL_FLAGS Flag = Shape.GridData[CellIndex];
+	return Flag == POLYZONE_CELL_FLAGS::Within || (AllowEdgeCells && Flag == POLYZONE_CELL_FLAGS::OnEdge);
+}
+
+void FPolyZone_GridSearch::BeginSearch(const FPolyZone_Shape& Shape)
+{
+	const int32 NumCells = Shape.GridData.Num();
+	if( VisitStamps.Num() < NumCells )
+	{
+		VisitStamps.SetNumZeroed(NumCells);
+		Parents.SetNumUninitialized(NumCells);
+		Costs.SetNumUninitialized(NumCells);
+		Queue.SetNumUninitialized(NumCells);
+		Scores.SetNumUninitialized(NumCells);
+		HeapSlots.SetNumUninitialized(NumCells);
+		OpenHeap.Reserve(NumCells); // Every cell is in the heap at most once
+	}
+
+	if( ++Stamp == 0 )
+	{
+		// Wrapped around, old stamps could match again
+		FMemory::Memzero(VisitStamps.GetData(), VisitStamps.Num() * sizeof(uint32));
+		Stamp = 1;
+	}
+}
+
+void FPolyZone_GridSearch::Visit(int32 CellIndex, int32 ParentIndex, float Cost)
+{
+	VisitStamps[CellIndex] = Stamp;
+	Parents[CellIndex] = ParentIndex;
+	Costs[CellIndex] = Cost;
+}
+
+// A* open set, a binary heap of cells ordered by Scores. HeapSlots says where each open cell sits (INDEX_NONE once popped),
+// so a cheaper route moves the cell up instead of pushing it a second time
+void FPolyZone_GridSearch::OpenCell(int32 CellIndex, float Score)
+{
+	Scores[CellIndex] = Score;
+	int32 Slot = HeapSlots[CellIndex];
+	if( Slot == INDEX_NONE )
+	{
+		Slot = OpenHeap.Add(CellIndex);
+	}
+
+	// Scores only ever drop, so the cell can only move up
+	while( Slot > 0 )
+	{
+		const int32 ParentSlot = (Slot - 1) / 2;
+		if( Scores[OpenHeap[ParentSlot]] <= Score )
+		{
+			break;
+		}
+		OpenHeap[Slot] = OpenHeap[ParentSlot];
+		HeapSlots[OpenHeap[Slot]] = Slot;
+		Slot = ParentSlot;
+	}
+	OpenHeap[Slot] = CellIndex;
+	HeapSlots[CellIndex] = Slot;
+}
+
+int32 FPolyZone_GridSearch::PopCheapestCell()
+{
+	const int32 CheapestCell = OpenHeap[0];
+	HeapSlots[CheapestCell] = INDEX_NONE;
+
+	const int32 LastCell = OpenHeap.Pop(false);
+	const int32 NumOpen = OpenHeap.Num();
+	if( NumOpen > 0 )
+	{
+		const float LastScore = Scores[LastCell];
+		int32 Slot = 0;
+		for( int32 Child = 1; Child < NumOpen; Child = Slot * 2 + 1 )
+		{
+			if( Child + 1 < NumOpen && Scores[OpenHeap[Child + 1]] < Scores[OpenHeap[Child]] )
+			{
+				++Child;
+			}
+			if( LastScore <= Scores[OpenHeap[Child]] )
+			{
+				break;
+			}
+			OpenHeap[Slot] = OpenHeap[Child];
+			HeapSlots[OpenHeap[Slot]] = Slot;
+			Slot = Child;
+		}
+		OpenHeap[Slot] = LastCell;
+		HeapSlots[LastCell] = Slot;
+	}
+	return CheapestCell;
+}
+
+void FPolyZone_GridSearch::BuildPath(int32 GoalIndex, TArray<int32>& OutPath) const
+{
+	for( int32 CellIndex = GoalIndex; CellIndex != INDEX_NONE; CellIndex = Parents[CellIndex] )
+	{
+		OutPath.Add(CellIndex);
+	}
+	Algo::Reverse(OutPath);
+}
+
+bool FPolyZone_GridSearch::FloodFill(const FPolyZone_Shape& Shape, int32 StartIndex, bool AllowEdgeCells, TArray<int32>& OutCells, int32 MaxCells)
+{
+	OutCells.Reset();
+	if( !IsWalkable(Shape, StartIndex, AllowEdgeCells) )
+	{
+		return false;
+	}
+
+	BeginSearch(Shape);
+	int32 Head = 0;
+	int32 Tail = 0;
+	Visit(StartIndex, INDEX_NONE, 0.0f);
+	Queue[Tail++] = StartIndex;
+
+	// Every cell is queued at most once, so the queue never outgrows the grid
+	while( Head < Tail && OutCells.Num() < MaxCells )
+	{
+		const int32 CellIndex = Queue[Head++];
+		OutCells.Add(CellIndex);
+
+		const int32 X = CellIndex % Shape.GridCellsX;
+		const int32 Y = CellIndex / Shape.GridCellsX;
+		for( const FIntPoint& Step : CardinalSteps )
+		{
+			const int32 NextX = X + Step.X;
+			const int32 NextY = Y + Step.Y;
+			const int32 NextIndex = NextX + NextY * Shape.GridCellsX;
+			if( IsInGrid(Shape, NextX, NextY) && !IsVisited(NextIndex) && IsWalkable(Shape, NextIndex, AllowEdgeCells) )
+			{
+				Visit(NextIndex, CellIndex, 0.0f);
+				Queue[Tail++] = NextIndex;
+			}
+		}
+	}
+	return true;
+}
+
+bool FPolyZone_GridSearch::FindPathBFS(const FPolyZone_Shape& Shape, int32 StartIndex, int32 GoalIndex, bool AllowEdgeCells, TArray<int32>& OutPath)
+{
+	OutPath.Reset();
+	if( !IsWalkable(Shape, StartIndex, AllowEdgeCells) || !IsWalkable(Shape, GoalIndex, AllowEdgeCells) )
+	{
+		return false;
+	}
+	if( !AllowEdgeCells && Shape.GetCellComponent(StartIndex) != Shape.GetCellComponent(GoalIndex) )
+	{
+		return false; // Separate islands, no need to search the whole island to find out
+	}
+
+	BeginSearch(Shape);
+	int32 Head = 0;
+	int32 Tail = 0;
+	Visit(StartIndex, INDEX_NONE, 0.0f);
+	Queue[Tail++] = StartIndex;
+
+	while( Head < Tail )
+	{
+		const int32 CellIndex = Queue[Head++];
+		if( CellIndex == GoalIndex )
+		{
+			BuildPath(GoalIndex, OutPath);
+			return true;
+		}
+
+		const int32 X = CellIndex % Shape.GridCellsX;
+		const int32 Y = CellIndex / Shape.GridCellsX;
+		for( const FIntPoint& Step : CardinalSteps )
+		{
+			const int32 NextX = X + Step.X;
+			const int32 NextY = Y + Step.Y;
+			const int32 NextIndex = NextX + NextY * Shape.GridCellsX;
+			if( IsInGrid(Shape, NextX, NextY) && !IsVisited(NextIndex) && IsWalkable(Shape, NextIndex, AllowEdgeCells) )
+			{
+				Visit(NextIndex, CellIndex, 0.0f);
+				Queue[Tail++] = NextIndex;
+			}
+		}
+	}
+	return false;
+}
+
+bool FPolyZone_GridSearch::FindPathAStar(const FPolyZone_Shape& Shape, int32 StartIndex, int32 GoalIndex, bool AllowEdgeCells, TArray<int32>& OutPath)
+{
+	OutPath.Reset();
+	if( !IsWalkable(Shape, StartIndex, AllowEdgeCells) || !IsWalkable(Shape, GoalIndex, AllowEdgeCells) )
+	{
+		return false;
+	}
+	if( !AllowEdgeCells && Shape.GetCellComponent(StartIndex) != Shape.GetCellComponent(GoalIndex) )
+	{
+		return false; // Separate islands
+	}
+
+	const int32 GoalX = GoalIndex % Shape.GridCellsX;
+	const int32 GoalY = GoalIndex / Shape.GridCellsX;
+	auto Heuristic = [GoalX, GoalY](int32 X, int32 Y) // Octile distance, exact on an empty grid
+	{
+		const int32 DeltaX = FMath::Abs(X - GoalX);
+		const int32 DeltaY = FMath::Abs(Y - GoalY);
+		return float(DeltaX + DeltaY) + (UE_SQRT_2 - 2.0f) * FMath::Min(DeltaX, DeltaY);
+	};
+
+	BeginSearch(Shape);
+	OpenHeap.Reset();
+	Visit(StartIndex, INDEX_NONE, 0.0f);
+	HeapSlots[StartIndex] = INDEX_NONE;
+	OpenCell(StartIndex, Heuristic(StartIndex % Shape.GridCellsX, StartIndex / Shape.GridCellsX));
+
+	while( OpenHeap.Num() > 0 )
+	{
+		const int32 CellIndex = PopCheapestCell();
+		const int32 X = CellIndex % Shape.GridCellsX;
+		const int32 Y = CellIndex / Shape.GridCellsX;
+		if( CellIndex == GoalIndex )
+		{
+			BuildPath(GoalIndex, OutPath);
+			return true;
+		}
+
+		auto TryStep = [&](int32 NextX, int32 NextY, float StepCost)
+		{
+			const int32 NextIndex = NextX + NextY * Shape.GridCellsX;
+			const float NextCost = Costs[CellIndex] + StepCost;
+			const bool FirstVisit = !IsVisited(NextIndex);
+			if( FirstVisit || NextCost < Costs[NextIndex] )
+			{
+				if( FirstVisit )
+				{
+					HeapSlots[NextIndex] = INDEX_NONE; // Left over from an earlier search
+				}
+				Visit(NextIndex, CellIndex, NextCost);
+				OpenCell(NextIndex, NextCost + Heuristic(NextX, NextY));
+			}
+		};
+
+		for( const FIntPoint& Step : CardinalSteps )
+		{
+			if( IsInGrid(Shape, X + Step.X, Y + Step.Y) && IsWalkable(Shape, (X + Step.X) + (Y + Step.Y) * Shape.GridCellsX, AllowEdgeCells) )
+			{
+				TryStep(X + Step.X, Y + Step.Y, 1.0f);
+			}
+		}
+		for( const FIntPoint& Step : DiagonalSteps )
+		{
+			// Both cells beside the diagonal must be walkable, so paths never squeeze through a corner of the polygon
+			if( IsInGrid(Shape, X + Step.X, Y + Step.Y) && IsWalkable(Shape, (X + Step.X) + (Y + Step.Y) * Shape.GridCellsX, AllowEdgeCells) &&
+				IsWalkable(Shape, (X + Step.X) + Y * Shape.GridCellsX, AllowEdgeCells) && IsWalkable(Shape, X + (Y + Step.Y) * Shape.GridCellsX, AllowEdgeCells) )
+			{
+				TryStep(X + Step.X, Y + Step.Y, UE_SQRT_2);
+			}
+		}
+	}
+	return false;
+}
+
+// Searches square rings around the closest grid cell, and stops once a ring can't hold anything closer than the best so far
+int32 FPolyZone_GridSearch::FindNearestWalkableCell(const FPolyZone_Shape& Shape, const FVector2D& LocalPoint, bool AllowEdgeCells)
+{
+	if( !Shape.UsesGrid || Shape.GridCellsX <= 0 || Shape.GridCellsY <= 0 )
+	{
+		return INDEX_NONE;
+	}
+
+	const FVector2D GridPoint = (LocalPoint - Shape.GridOrigin) * Shape.InvCellSize; // In cells
+	const int32 StartX = FMath::Clamp(FMath::FloorToInt32(GridPoint.X), 0, Shape.GridCellsX - 1);
+	const int32 StartY = FMath::Clamp(FMath::FloorToInt32(GridPoint.Y), 0, Shape.GridCellsY - 1);
+	const double StartDistance = FVector2D::Distance(GridPoint, FVector2D(StartX + 0.5, StartY + 0.5));
+	const int32 MaxRing = FMath::Max(Shape.GridCellsX, Shape.GridCellsY);
+
+	int32 BestIndex = INDEX_NONE;
+	double BestDistanceSquared = TNumericLimits<double>::Max();
+	for( int32 Ring = 0; Ring <= MaxRing; ++Ring )
+	{
+		// Every center in this ring is at least Ring cells from the start center
+		const double RingDistance = Ring - StartDistance;
+		if( BestIndex != INDEX_NONE && RingDistance > 0.0 && FMath::Square(RingDistance) > BestDistanceSquared )
+		{
+			break;
+		}
+
+		for( int32 Y = StartY - Ring; Y <= StartY + Ring; ++Y )
+		{
+			const bool IsEdgeRow = (Y == StartY - Ring) || (Y == StartY + Ring);
+			const int32 StepX = IsEdgeRow ? 1 : FMath::Max(1, Ring * 2); // Only the ring itself, not the inside
+			for( int32 X = StartX - Ring; X <= StartX + Ring; X += StepX )
+			{
+				const int32 CellIndex = X + Y * Shape.GridCellsX;
+				if( !IsInGrid(Shape, X, Y) || !IsWalkable(Shape, CellIndex, AllowEdgeCells) )
+				{
+					continue;
+				}
+				const double DistanceSquared = FVector2D::DistSquared(GridPoint, FVector2D(X + 0.5, Y + 0.5));
+				if( DistanceSquared < BestDistanceSquared )
+				{
+					BestDistanceSquared = DistanceSquared;
+					BestIndex = CellIndex;
+				}
+			}
+		}
+	}
+	return BestIndex;
+}
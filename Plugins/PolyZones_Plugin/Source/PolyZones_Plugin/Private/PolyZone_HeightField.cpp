@@ -0,0 +1,48 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_HeightField.h"
+#include "PolyZone_Shape.h"
+
+void FPolyZone_HeightField::Build(const FPolyZone_Shape& Shape, TFunctionRef<double(const FVector2D& LocalPoint)> SampleFloor)
+{
+	GridOrigin = Shape.GridOrigin;
+	InvCellSize = Shape.InvCellSize;
+	CellsX = Shape.GridCellsX;
+	CellsY = Shape.GridCellsY;
+	FloorRanges.Reset();
+	TotalRange = FFloatInterval(0.0f, 0.0f);
+	if( !Shape.UsesGrid || CellsX <= 0 || CellsY <= 0 )
+	{
+		return;
+	}
+
+	// Neighbouring cells share their corners, so each corner is only sampled once
+	const int32 CornersX = CellsX + 1;
+	TArray<float> CornerFloors;
+	CornerFloors.SetNumUninitialized(CornersX * (CellsY + 1));
+	for( int32 CornerY = 0; CornerY <= CellsY; CornerY++ )
+	{
+		for( int32 CornerX = 0; CornerX < CornersX; CornerX++ )
+		{
+			CornerFloors[CornerX + CornerY * CornersX] = SampleFloor(GridOrigin + FVector2D(CornerX, CornerY) * Shape.CellSize);
+		}
+	}
+
+	FloorRanges.SetNumUninitialized(CellsX * CellsY);
+	TotalRange = FFloatInterval(); // Invalid until the first Include
+	for( int32 GridY = 0; GridY < CellsY; GridY++ )
+	{
+		for( int32 GridX = 0; GridX < CellsX; GridX++ )
+		{
+			// The center catches bumps smaller than a cell
+			FFloatInterval& FloorRange = FloorRanges[GridX + GridY * CellsX];
+			FloorRange.Min = FloorRange.Max = SampleFloor(GridOrigin + FVector2D(GridX + 0.5, GridY + 0.5) * Shape.CellSize);
+			for( const FIntPoint& Corner : { FIntPoint(0, 0), FIntPoint(1, 0), FIntPoint(0, 1), FIntPoint(1, 1) } )
+			{
+				FloorRange.Include(CornerFloors[(GridX + Corner.X) + (GridY + Corner.Y) * CornersX]);
+			}
+			TotalRange.Include(FloorRange.Min);
+			TotalRange.Include(FloorRange.Max);
+		}
+	}
+}
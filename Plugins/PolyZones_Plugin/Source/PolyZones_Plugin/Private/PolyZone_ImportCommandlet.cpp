@@ -0,0 +1,84 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_ImportCommandlet.h"
+#include "PolyZone_Importer.h"
+#include "PolyZone_ZoneSet.h"
+#include "PolyZones_Plugin.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+UPolyZone_ImportCommandlet::UPolyZone_ImportCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = true;
+	LogToConsole = true;
+	ShowErrorCount = true;
+}
+
+int32 UPolyZone_ImportCommandlet::Main(const FString& Params)
+{
+	FString SourcePath;
+	FString AssetPath;
+	if( !FParse::Value(*Params, TEXT("Source="), SourcePath) || !FParse::Value(*Params, TEXT("Asset="), AssetPath) )
+	{
+		UE_LOG(LogPolyZones, Error, TEXT("Usage: -run=PolyZone_Import -Source=<file> -Asset=/Game/Path/Name [-Scale=100] [-Geographic] [-NoFlipY] [-Height=250]"));
+		return 1;
+	}
+	if( !FPackageName::IsValidLongPackageName(AssetPath) )
+	{
+		UE_LOG(LogPolyZones, Error, TEXT("%s is not a valid package name"), *AssetPath);
+		return 1;
+	}
+
+	FPolyZone_ImportSettings Settings;
+	FParse::Value(*Params, TEXT("Scale="), Settings.Scale);
+	FParse::Value(*Params, TEXT("Height="), Settings.DefaultHeight);
+	Settings.bGeographic = FParse::Param(*Params, TEXT("Geographic"));
+	Settings.bFlipY = !FParse::Param(*Params, TEXT("NoFlipY"));
+
+	double StartTime = FPlatformTime::Seconds();
+	TArray<FPolyZone_ImportedZone> Zones;
+	FString Error;
+	if( !FPolyZone_Importer::ParseFile(SourcePath, Settings, Zones, Error) )
+	{
+		UE_LOG(LogPolyZones, Error, TEXT("PolyZone import failed: %s"), *Error);
+		return 1;
+	}
+	const double ParseMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	StartTime = FPlatformTime::Seconds();
+	FPolyZone_Importer::BuildZones(Zones, FPolyZone_ShapeSettings()); // The settings a zone set uses
+	const double BuildMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	#if WITH_EDITOR
+	StartTime = FPlatformTime::Seconds();
+	UPackage* Package = CreatePackage(*AssetPath);
+	Package->FullyLoad();
+	const FName AssetName = FPackageName::GetShortFName(AssetPath);
+	if( UObject* Existing = FindObject<UObject>(Package, *AssetName.ToString()) )
+	{
+		Existing->Rename(nullptr, GetTransientPackage(), REN_DontCreateRedirectors | REN_NonTransactional); // Reimport replaces the old set
+	}
+	UPolyZone_ZoneSet* ZoneSet = FPolyZone_Importer::CreateZoneSet(Zones, Package, AssetName, RF_Public | RF_Standalone);
+	Package->MarkPackageDirty();
+
+	const FString FileName = FPackageName::LongPackageNameToFilename(AssetPath, FPackageName::GetAssetPackageExtension());
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	if( !UPackage::SavePackage(Package, ZoneSet, *FileName, SaveArgs) )
+	{
+		UE_LOG(LogPolyZones, Error, TEXT("PolyZone import could not save %s"), *FileName);
+		return 1;
+	}
+	const double SaveMs = (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	UE_LOG(LogPolyZones, Display, TEXT("Imported %d zones into %s (parse %.1f ms, build %.1f ms, save %.1f ms, %d unique shapes)"), Zones.Num(), *AssetPath, ParseMs, BuildMs,
+		SaveMs, FPolyZone_Shape::GetNumCachedShapes());
+	return 0;
+	#else
+	UE_LOG(LogPolyZones, Error, TEXT("PolyZone import can only save assets in the editor"));
+	return 1;
+	#endif
+}
@@ -0,0 +1,21 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "PolyZone_ImportCommandlet.generated.h"
+
+/*Imports a GeoJSON or CSV file into a zone set asset, the shapes are built on every core and their cells saved with the asset
+ *
+ *UnrealEditor-Cmd ZonesProject.uproject -run=PolyZone_Import -Source=Path/Zones.geojson -Asset=/Game/Zones/ZoneSet [-Scale=100] [-Geographic] [-NoFlipY] [-Height=250]*/
+UCLASS()
+class UPolyZone_ImportCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPolyZone_ImportCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
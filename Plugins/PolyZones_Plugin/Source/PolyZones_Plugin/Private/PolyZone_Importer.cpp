@@ -0,0 +1,416 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_Importer.h"
+#include "PolyZone.h"
+#include "PolyZone_ZoneSet.h"
+#include "PolyZones_Plugin.h"
+#include "Async/ParallelFor.h"
+#include "Dom/JsonObject.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+
+namespace
+{
+	constexpr double MetersPerDegree = 6378137.0 * PI / 180.0; // WGS84 equatorial radius
+
+	bool ReadRing(const TArray<TSharedPtr<FJsonValue>>& Ring, TArray<FVector2D>& OutPolygon)
+	{
+		OutPolygon.Reset(Ring.Num());
+		for( const TSharedPtr<FJsonValue>& Position : Ring )
+		{
+			const TArray<TSharedPtr<FJsonValue>>* Coordinates = nullptr;
+			if( !Position.IsValid() || !Position->TryGetArray(Coordinates) || Coordinates->Num() < 2 )
+			{
+				return false;
+			}
+			OutPolygon.Add(FVector2D((*Coordinates)[0]->AsNumber(), (*Coordinates)[1]->AsNumber()));
+		}
+
+		// GeoJSON rings repeat the first position at the end, the spline closes itself
+		if( OutPolygon.Num() > 1 && OutPolygon[0].Equals(OutPolygon.Last()) )
+		{
+			OutPolygon.Pop(false);
+		}
+		return OutPolygon.Num() >= 3;
+	}
+
+	// Holes are ignored, a zone is a single outline
+	void ReadPolygon(const TArray<TSharedPtr<FJsonValue>>& Rings, FName Name, float Height, TArray<FPolyZone_ImportedZone>& OutZones)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* OuterRing = nullptr;
+		if( Rings.Num() == 0 || !Rings[0].IsValid() || !Rings[0]->TryGetArray(OuterRing) )
+		{
+			return;
+		}
+
+		FPolyZone_ImportedZone Zone;
+		Zone.Name = Name;
+		Zone.Height = Height;
+		if( ReadRing(*OuterRing, Zone.WorldPolygon) )
+		{
+			OutZones.Add(MoveTemp(Zone));
+		}
+		else
+		{
+			UE_LOG(LogPolyZones, Warning, TEXT("PolyZone import skipped polygon %s, it has less than 3 points or malformed coordinates"), *Name.ToString());
+		}
+	}
+
+	void ReadGeometry(const TSharedPtr<FJsonObject>& Geometry, FName Name, float Height, TArray<FPolyZone_ImportedZone>& OutZones)
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Coordinates = nullptr;
+		if( !Geometry.IsValid() || !Geometry->TryGetArrayField(TEXT("coordinates"), Coordinates) )
+		{
+			return;
+		}
+
+		const FString Type = Geometry->GetStringField(TEXT("type"));
+		if( Type == TEXT("Polygon") )
+		{
+			ReadPolygon(*Coordinates, Name, Height, OutZones);
+		}
+		else if( Type == TEXT("MultiPolygon") )
+		{
+			// One zone per part, numbered after the first so names stay unique
+			for( int32 Part = 0; Part < Coordinates->Num(); ++Part )
+			{
+				const TArray<TSharedPtr<FJsonValue>>* Rings = nullptr;
+				if( (*Coordinates)[Part]->TryGetArray(Rings) )
+				{
+					ReadPolygon(*Rings, Part == 0 ? Name : FName(Name, Part), Height, OutZones);
+				}
+			}
+		}
+		else
+		{
+			UE_LOG(LogPolyZones, Verbose, TEXT("PolyZone import skipped %s geometry %s"), *Type, *Name.ToString());
+		}
+	}
+
+	void ReadFeature(const TSharedPtr<FJsonObject>& Feature, int32 FeatureIndex, TArray<FPolyZone_ImportedZone>& OutZones)
+	{
+		FString Name = FString::Printf(TEXT("Zone_%d"), FeatureIndex);
+		float Height = 0.0f; // Zero takes the default height later
+
+		const TSharedPtr<FJsonObject>* Properties = nullptr;
+		if( Feature->TryGetObjectField(TEXT("properties"), Properties) && Properties->IsValid() )
+		{
+			if( !(*Properties)->TryGetStringField(TEXT("name"), Name) )
+			{
+				(*Properties)->TryGetStringField(TEXT("id"), Name); // Numbers are read as strings too
+			}
+			double PropertyHeight = 0.0;
+			if( (*Properties)->TryGetNumberField(TEXT("height"), PropertyHeight) )
+			{
+				Height = PropertyHeight;
+			}
+		}
+
+		const TSharedPtr<FJsonObject>* Geometry = nullptr;
+		if( Feature->TryGetObjectField(TEXT("geometry"), Geometry) )
+		{
+			ReadGeometry(*Geometry, FName(*Name), Height, OutZones);
+		}
+	}
+
+	// Splits a CSV line on commas and trims the cells, quoted cells can't contain commas
+	void SplitCsvLine(const FString& Line, TArray<FString>& OutCells)
+	{
+		Line.ParseIntoArray(OutCells, TEXT(","), false);
+		for( FString& Cell : OutCells )
+		{
+			Cell.TrimStartAndEndInline();
+			Cell.TrimQuotesInline();
+		}
+	}
+}
+
+bool FPolyZone_Importer::ParseFile(const FString& FilePath, const FPolyZone_ImportSettings& Settings, TArray<FPolyZone_ImportedZone>& OutZones, FString& OutError)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPolyZone_Importer::ParseFile);
+
+	FString Text;
+	if( !FFileHelper::LoadFileToString(Text, *FilePath) )
+	{
+		OutError = FString::Printf(TEXT("Could not read %s"), *FilePath);
+		return false;
+	}
+
+	const FString Extension = FPaths::GetExtension(FilePath).ToLower();
+	if( Extension == TEXT("csv") )
+	{
+		return ParseCsv(Text, Settings, OutZones, OutError);
+	}
+	if( Extension == TEXT("geojson") || Extension == TEXT("json") )
+	{
+		return ParseGeoJson(Text, Settings, OutZones, OutError);
+	}
+
+	OutError = FString::Printf(TEXT("%s is not a .geojson, .json or .csv file"), *FilePath);
+	return false;
+}
+
+bool FPolyZone_Importer::ParseGeoJson(const FString& Text, const FPolyZone_ImportSettings& Settings, TArray<FPolyZone_ImportedZone>& OutZones, FString& OutError)
+{
+	TSharedPtr<FJsonObject> Root;
+	if( !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) || !Root.IsValid() )
+	{
+		OutError = TEXT("Not valid JSON");
+		return false;
+	}
+
+	OutZones.Reset();
+	const FString Type = Root->GetStringField(TEXT("type"));
+	if( Type == TEXT("FeatureCollection") )
+	{
+		const TArray<TSharedPtr<FJsonValue>>* Features = nullptr;
+		if( Root->TryGetArrayField(TEXT("features"), Features) )
+		{
+			for( int32 FeatureIndex = 0; FeatureIndex < Features->Num(); ++FeatureIndex )
+			{
+				const TSharedPtr<FJsonObject>* Feature = nullptr;
+				if( (*Features)[FeatureIndex]->TryGetObject(Feature) )
+				{
+					ReadFeature(*Feature, FeatureIndex, OutZones);
+				}
+			}
+		}
+	}
+	else if( Type == TEXT("Feature") )
+	{
+		ReadFeature(Root, 0, OutZones);
+	}
+	else
+	{
+		ReadGeometry(Root, TEXT("Zone_0"), 0.0f, OutZones);
+	}
+
+	if( OutZones.Num() == 0 )
+	{
+		OutError = TEXT("No Polygon or MultiPolygon geometry found");
+		return false;
+	}
+
+	ApplySettings(OutZones, Settings);
+	return true;
+}
+
+bool FPolyZone_Importer::ParseCsv(const FString& Text, const FPolyZone_ImportSettings& Settings, TArray<FPolyZone_ImportedZone>& OutZones, FString& OutError)
+{
+	TArray<FString> Lines;
+	Text.ParseIntoArrayLines(Lines);
+
+	OutZones.Reset();
+	TMap<FName, int32> ZoneIndices; // Rows of one zone don't have to be next to each other, the vertex order is the row order
+	TArray<FString> Cells;
+	for( int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex )
+	{
+		SplitCsvLine(Lines[LineIndex], Cells);
+		if( Cells.Num() < 3 || Cells[0].StartsWith(TEXT("#")) )
+		{
+			continue;
+		}
+		if( !Cells[1].IsNumeric() || !Cells[2].IsNumeric() )
+		{
+			if( LineIndex == 0 )
+			{
+				continue; // Header
+			}
+			OutError = FString::Printf(TEXT("Line %d: x and y must be numbers"), LineIndex + 1);
+			return false;
+		}
+
+		const FName Name(*Cells[0]);
+		int32* ZoneIndex = ZoneIndices.Find(Name);
+		if( !ZoneIndex )
+		{
+			ZoneIndex = &ZoneIndices.Add(Name, OutZones.AddDefaulted());
+			OutZones[*ZoneIndex].Name = Name;
+		}
+
+		FPolyZone_ImportedZone& Zone = OutZones[*ZoneIndex];
+		Zone.WorldPolygon.Add(FVector2D(FCString::Atod(*Cells[1]), FCString::Atod(*Cells[2])));
+		if( Cells.Num() > 3 && Cells[3].IsNumeric() )
+		{
+			Zone.Height = FCString::Atof(*Cells[3]); // Any row of the zone can carry the height
+		}
+	}
+
+	const int32 NumRead = OutZones.Num();
+	OutZones.RemoveAll([](const FPolyZone_ImportedZone& Zone) { return Zone.WorldPolygon.Num() < 3; });
+	if( OutZones.Num() < NumRead )
+	{
+		UE_LOG(LogPolyZones, Warning, TEXT("PolyZone import skipped %d zones with less than 3 points"), NumRead - OutZones.Num());
+	}
+	if( OutZones.Num() == 0 )
+	{
+		OutError = TEXT("No zones with 3 or more points found");
+		return false;
+	}
+
+	ApplySettings(OutZones, Settings);
+	return true;
+}
+
+void FPolyZone_Importer::ApplySettings(TArray<FPolyZone_ImportedZone>& Zones, const FPolyZone_ImportSettings& Settings)
+{
+	// Equirectangular projection around the first point, the scale below turns the meters into cm
+	const FVector2D Reference = Zones.Num() > 0 ? Zones[0].WorldPolygon[0] : FVector2D::ZeroVector;
+	const double MetersPerDegreeX = MetersPerDegree * FMath::Cos(FMath::DegreesToRadians(Reference.Y));
+
+	for( FPolyZone_ImportedZone& Zone : Zones )
+	{
+		for( FVector2D& Point : Zone.WorldPolygon )
+		{
+			if( Settings.bGeographic )
+			{
+				Point = FVector2D((Point.X - Reference.X) * MetersPerDegreeX, (Point.Y - Reference.Y) * MetersPerDegree);
+			}
+			Point *= Settings.Scale;
+			if( Settings.bFlipY )
+			{
+				Point.Y = -Point.Y;
+			}
+			Point += FVector2D(Settings.Offset.X, Settings.Offset.Y);
+		}
+
+		Zone.Height = Zone.Height > 0.0f ? Zone.Height * Settings.Scale : Settings.DefaultHeight;
+		Zone.Origin.Z = Settings.Offset.Z;
+	}
+}
+
+void FPolyZone_Importer::BuildZones(TArray<FPolyZone_ImportedZone>& Zones, const FPolyZone_ShapeSettings& ShapeSettings)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPolyZone_Importer::BuildZones);
+
+	// FindOrBuild is thread safe, zones are independent so every one gets its own task
+	ParallelFor(Zones.Num(), [&Zones, &ShapeSettings](int32 Index)
+	{
+		FPolyZone_ImportedZone& Zone = Zones[Index];
+		const FBox2D Bounds(Zone.WorldPolygon);
+		const FVector2D Center = Bounds.GetCenter();
+		Zone.Origin = FVector(Center.X, Center.Y, Zone.Origin.Z);
+
+		Zone.LocalPolygon.Reset(Zone.WorldPolygon.Num());
+		for( const FVector2D& Point : Zone.WorldPolygon )
+		{
+			Zone.LocalPolygon.Add(Point - Center);
+		}
+		Zone.Shape = FPolyZone_Shape::FindOrBuild(Zone.LocalPolygon, ShapeSettings);
+	});
+}
+
+UPolyZone_ZoneSet* FPolyZone_Importer::CreateZoneSet(const TArray<FPolyZone_ImportedZone>& Zones, UObject* Outer, FName Name, EObjectFlags Flags)
+{
+	UPolyZone_ZoneSet* ZoneSet = NewObject<UPolyZone_ZoneSet>(Outer ? Outer : GetTransientPackage(), Name, Flags);
+	ZoneSet->Zones.Reserve(Zones.Num());
+	for( const FPolyZone_ImportedZone& Zone : Zones )
+	{
+		FPolyZone_ZoneSetEntry& Entry = ZoneSet->Zones.AddDefaulted_GetRef();
+		Entry.Name = Zone.Name;
+		Entry.Origin = Zone.Origin;
+		Entry.Height = Zone.Height;
+		Entry.Polygon = Zone.LocalPolygon;
+		Entry.Bounds = FBox2D(Zone.WorldPolygon);
+	}
+
+	// Cache hits when the zones were built with default settings, the cells are saved with the asset either way
+	ZoneSet->BuildShapes();
+	const FPolyZone_ShapeSettings DefaultSettings;
+	for( int32 Index = 0; Index < ZoneSet->Zones.Num(); ++Index )
+	{
+		if( const FPolyZone_ShapePtr Shape = ZoneSet->GetShape(Index) )
+		{
+			FPolyZone_ZoneSetEntry& Entry = ZoneSet->Zones[Index];
+			Entry.BakedGrid.Bake(FPolyZone_Shape::GetSourceHash(Entry.Polygon, DefaultSettings), Entry.Polygon, Shape->GridData);
+		}
+	}
+	return ZoneSet;
+}
+
+TArray<APolyZone*> FPolyZone_Importer::SpawnZones(UWorld* World, const TArray<FPolyZone_ImportedZone>& Zones, TSubclassOf<APolyZone> ZoneClass)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPolyZone_Importer::SpawnZones);
+
+	TArray<APolyZone*> SpawnedZones;
+	SpawnedZones.Reserve(Zones.Num());
+	for( const FPolyZone_ImportedZone& Zone : Zones )
+	{
+		if( APolyZone* SpawnedZone = SpawnZone(World, ZoneClass, Zone.Name, Zone.Origin, Zone.Height, Zone.LocalPolygon) )
+		{
+			SpawnedZones.Add(SpawnedZone);
+		}
+	}
+	return SpawnedZones;
+}
+
+APolyZone* FPolyZone_Importer::SpawnZone(UWorld* World, TSubclassOf<APolyZone> ZoneClass, FName Name, const FVector& Origin, float Height, const TArray<FVector2D>& LocalPolygon)
+{
+	if( !World || LocalPolygon.Num() < 3 )
+	{
+		return nullptr;
+	}
+
+	const FTransform Transform(Origin);
+	APolyZone* Zone = World->SpawnActorDeferred<APolyZone>(ZoneClass ? ZoneClass.Get() : APolyZone::StaticClass(), Transform);
+	if( !Zone )
+	{
+		return nullptr;
+	}
+
+	Zone->ZoneHeight = Height;
+	TArray<FVector> SplinePoints;
+	SplinePoints.Reserve(LocalPolygon.Num());
+	for( const FVector2D& Point : LocalPolygon )
+	{
+		SplinePoints.Add(FVector(Point.X, Point.Y, 0.0));
+	}
+	Zone->PolySpline->SetSplinePoints(SplinePoints, ESplineCoordinateSpace::Local, true);
+	#if WITH_EDITOR
+	if( !Name.IsNone() )
+	{
+		Zone->SetActorLabel(Name.ToString());
+	}
+	#endif
+	Zone->FinishSpawning(Transform); // Construction finds the shape BuildZones put in the cache
+	return Zone;
+}
+
+UPolyZone_ZoneSet* UPolyZone_ImportLibrary::ImportZoneSet(const FString& FilePath, const FPolyZone_ImportSettings& Settings)
+{
+	TArray<FPolyZone_ImportedZone> Zones;
+	FString Error;
+	if( !FPolyZone_Importer::ParseFile(FilePath, Settings, Zones, Error) )
+	{
+		UE_LOG(LogPolyZones, Error, TEXT("PolyZone import failed: %s"), *Error);
+		return nullptr;
+	}
+
+	FPolyZone_Importer::BuildZones(Zones, FPolyZone_ShapeSettings());
+	return FPolyZone_Importer::CreateZoneSet(Zones, GetTransientPackage());
+}
+
+TArray<APolyZone*> UPolyZone_ImportLibrary::SpawnZonesFromFile(const UObject* WorldContextObject, const FString& FilePath, TSubclassOf<APolyZone> ZoneClass, const FPolyZone_ImportSettings& Settings)
+{
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	if( !World )
+	{
+		return {};
+	}
+
+	TArray<FPolyZone_ImportedZone> Zones;
+	FString Error;
+	if( !FPolyZone_Importer::ParseFile(FilePath, Settings, Zones, Error) )
+	{
+		UE_LOG(LogPolyZones, Error, TEXT("PolyZone import failed: %s"), *Error);
+		return {};
+	}
+
+	const APolyZone* ZoneDefaults = ZoneClass ? ZoneClass.GetDefaultObject() : GetDefault<APolyZone>();
+	FPolyZone_Importer::BuildZones(Zones, ZoneDefaults->GetShapeSettings());
+	return FPolyZone_Importer::SpawnZones(World, Zones, ZoneClass);
+}
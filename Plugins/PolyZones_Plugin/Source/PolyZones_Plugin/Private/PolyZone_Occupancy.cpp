@@ -0,0 +1,152 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_Occupancy.h"
+#include "Engine/Texture2D.h"
+
+void FPolyZone_Occupancy::Reset(int32 InCellsX, int32 InCellsY, double InHalfLife)
+{
+	CellsX = FMath::Max(0, InCellsX);
+	CellsY = FMath::Max(0, InCellsY);
+	DecayRate = UE_LN2 / FMath::Max(InHalfLife, UE_KINDA_SMALL_NUMBER);
+	Cells.Reset();
+	Cells.SetNum(CellsX * CellsY);
+	ActorCells.Reset();
+}
+
+void FPolyZone_Occupancy::Empty()
+{
+	Cells.Empty();
+	ActorCells.Empty();
+	CellsX = 0;
+	CellsY = 0;
+}
+
+void FPolyZone_Occupancy::SetActorCell(const AActor* Actor, int32 CellIndex, double Time)
+{
+	if( !Cells.IsValidIndex(CellIndex) )
+	{
+		CellIndex = INDEX_NONE;
+	}
+
+	int32* CurrentCell = ActorCells.Find(Actor);
+	if( (CurrentCell ? *CurrentCell : INDEX_NONE) == CellIndex )
+	{
+		return; // Most actors stay in their cell from one update to the next
+	}
+
+	if( CurrentCell )
+	{
+		AddToCell(*CurrentCell, -1, Time);
+	}
+
+	if( CellIndex == INDEX_NONE )
+	{
+		ActorCells.Remove(Actor);
+	}
+	else
+	{
+		AddToCell(CellIndex, 1, Time);
+		ActorCells.Add(Actor, CellIndex);
+	}
+}
+
+void FPolyZone_Occupancy::AddToCell(int32 CellIndex, int32 Delta, double Time)
+{
+	FCell& Cell = Cells[CellIndex];
+	Cell.History = GetHistoryAt(Cell, Time); // Settle the old count before changing it
+	Cell.LastTime = Time;
+	Cell.Count += Delta;
+}
+
+// The count has been constant since LastTime, so the exponential average has a closed form
+float FPolyZone_Occupancy::GetHistoryAt(const FCell& Cell, double Time) const
+{
+	const double Decay = FMath::Exp(-DecayRate * FMath::Max(0.0, Time - Cell.LastTime));
+	return Cell.Count + (Cell.History - Cell.Count) * Decay;
+}
+
+int32 FPolyZone_Occupancy::GetCount(int32 CellIndex) const
+{
+	return Cells.IsValidIndex(CellIndex) ? Cells[CellIndex].Count : 0;
+}
+
+float FPolyZone_Occupancy::GetHistory(int32 CellIndex, double Time) const
+{
+	return Cells.IsValidIndex(CellIndex) ? GetHistoryAt(Cells[CellIndex], Time) : 0.0f;
+}
+
+void FPolyZone_Occupancy::GetDensestCells(int32 MaxCells, bool UseHistory, double Time, TArray<int32>& OutCellIndices) const
+{
+	OutCellIndices.Reset();
+	if( MaxCells <= 0 )
+	{
+		return;
+	}
+
+	// Min heap of the best cells so far, the weakest one is always on top to be replaced
+	TArray<TPair<float, int32>> Best;
+	Best.Reserve(FMath::Min(MaxCells, Cells.Num()) + 1);
+	auto IsWeaker = [](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key < B.Key; };
+	for( int32 CellIndex = 0; CellIndex < Cells.Num(); ++CellIndex )
+	{
+		const float Value = UseHistory ? GetHistoryAt(Cells[CellIndex], Time) : Cells[CellIndex].Count;
+		if( Value <= UE_KINDA_SMALL_NUMBER )
+		{
+			continue;
+		}
+		if( Best.Num() < MaxCells )
+		{
+			Best.HeapPush(TPair<float, int32>(Value, CellIndex), IsWeaker);
+		}
+		else if( Value > Best.HeapTop().Key )
+		{
+			Best.HeapPopDiscard(IsWeaker);
+			Best.HeapPush(TPair<float, int32>(Value, CellIndex), IsWeaker);
+		}
+	}
+
+	Best.Sort([](const TPair<float, int32>& A, const TPair<float, int32>& B) { return A.Key > B.Key; });
+	for( const TPair<float, int32>& Entry : Best )
+	{
+		OutCellIndices.Add(Entry.Value);
+	}
+}
+
+FString FPolyZone_Occupancy::ToCsv(double Time) const
+{
+	FString Csv = TEXT("X,Y,Count,History\n");
+	Csv.Reserve(Csv.Len() + Cells.Num() * 24);
+	for( int32 CellIndex = 0; CellIndex < Cells.Num(); ++CellIndex )
+	{
+		Csv += FString::Printf(TEXT("%d,%d,%d,%.4f\n"), CellIndex % CellsX, CellIndex / CellsX, Cells[CellIndex].Count, GetHistoryAt(Cells[CellIndex], Time));
+	}
+	return Csv;
+}
+
+UTexture2D* FPolyZone_Occupancy::CreateTexture(bool UseHistory, double Time) const
+{
+	if( !IsValid() )
+	{
+		return nullptr;
+	}
+
+	UTexture2D* Texture = UTexture2D::CreateTransient(CellsX, CellsY, PF_R32_FLOAT);
+	if( !Texture )
+	{
+		return nullptr;
+	}
+	Texture->Filter = TF_Nearest; // One texel per cell
+	Texture->SRGB = false;
+	Texture->AddressX = TA_Clamp;
+	Texture->AddressY = TA_Clamp;
+
+	FTexture2DMipMap& Mip = Texture->GetPlatformData()->Mips[0];
+	float* Texels = static_cast<float*>(Mip.BulkData.Lock(LOCK_READ_WRITE));
+	for( int32 CellIndex = 0; CellIndex < Cells.Num(); ++CellIndex )
+	{
+		Texels[CellIndex] = UseHistory ? GetHistoryAt(Cells[CellIndex], Time) : Cells[CellIndex].Count;
+	}
+	Mip.BulkData.Unlock();
+	Texture->UpdateResource();
+	return Texture;
+}
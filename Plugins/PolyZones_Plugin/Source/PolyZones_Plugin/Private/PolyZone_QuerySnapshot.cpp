@@ -0,0 +1,65 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_QuerySnapshot.h"
+#include "PolyZone_Stats.h"
+
+FPolyZone_QuerySnapshot::FPolyZone_QuerySnapshot(const TSharedRef<const FPolyZone_Shape, ESPMode::ThreadSafe>& InShape, const FPolyZone_HeightFieldPtr& InHeightField,
+	const FPolyZone_Frame& InFrame, double InZoneHeight, const TSharedRef<std::atomic<uint32>, ESPMode::ThreadSafe>& InLatestVersion)
+	: Shape(InShape)
+	, HeightField(InHeightField)
+	, Frame(InFrame)
+	, ZoneHeight(InZoneHeight)
+	, Version(InLatestVersion->load(std::memory_order_acquire))
+	, LatestVersion(InLatestVersion)
+{
+}
+
+bool FPolyZone_QuerySnapshot::IsPointWithinPolyZone(const FVector& TestPoint, bool SkipHeight) const
+{
+	INC_DWORD_STAT(STAT_PolyZone_PointQueries);
+
+	const FVector2D LocalPoint = Frame.ToLocal(TestPoint);
+	if( !SkipHeight && !FPolyZone_HeightField::IsWithinZoneHeight(HeightField.Get(), LocalPoint, TestPoint.Z - Frame.Origin.Z, ZoneHeight) )
+	{
+		return false;
+	}
+	return Shape->IsPointWithinShape(LocalPoint);
+}
+
+void FPolyZone_QuerySnapshot::ArePointsWithinPolyZone(TConstArrayView<FVector> TestPoints, TArrayView<bool> OutResults, bool SkipHeight) const
+{
+	check(OutResults.Num() == TestPoints.Num());
+	INC_DWORD_STAT_BY(STAT_PolyZone_PointQueries, TestPoints.Num());
+
+	// Small batches stay on the stack, this is meant to be called from tasks
+	TArray<FVector2D, TInlineAllocator<64>> LocalPoints;
+	LocalPoints.SetNumUninitialized(TestPoints.Num());
+	for( int32 i = 0; i < TestPoints.Num(); ++i )
+	{
+		LocalPoints[i] = Frame.ToLocal(TestPoints[i]);
+	}
+	Shape->ArePointsWithinShape(LocalPoints, OutResults);
+
+	if( !SkipHeight )
+	{
+		for( int32 i = 0; i < TestPoints.Num(); ++i )
+		{
+			OutResults[i] = OutResults[i] && FPolyZone_HeightField::IsWithinZoneHeight(HeightField.Get(), LocalPoints[i], TestPoints[i].Z - Frame.Origin.Z, ZoneHeight);
+		}
+	}
+}
+
+POLYZONE_CELL_FLAGS FPolyZone_QuerySnapshot::GetFlagAtLocation(const FVector& Location) const
+{
+	return Shape->GetCellFlagAtLocal(Frame.ToLocal(Location));
+}
+
+FPolyZone_GridCell FPolyZone_QuerySnapshot::GetGridCellAtLocation(const FVector& Location) const
+{
+	return Shape->GetGridCellAtLocation(Frame.ToLocal(Location));
+}
+
+POLYZONE_CELL_FLAGS FPolyZone_QuerySnapshot::GetGridCellFlag(const FPolyZone_GridCell& Cell) const
+{
+	return Shape->GetGridCellFlag(Cell);
+}
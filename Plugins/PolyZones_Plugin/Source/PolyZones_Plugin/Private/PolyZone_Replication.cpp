@@ -0,0 +1,53 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_Replication.h"
+#include "PolyZone.h"
+
+// ==================== CLIENT ====================
+
+void FPolyZone_MemberItem::PostReplicatedAdd(const FPolyZone_MemberArray& InArraySerializer)
+{
+	if( IsValid(Actor) && IsValid(InArraySerializer.Owner) )
+	{
+		InArraySerializer.Owner->OnReplicatedMemberChange(Actor, true);
+		bEntered = true;
+	}
+}
+
+void FPolyZone_MemberItem::PostReplicatedChange(const FPolyZone_MemberArray& InArraySerializer)
+{
+	// The actor reference was not mapped when the item was added, now that it is we can send the enter
+	if( !bEntered && IsValid(Actor) && IsValid(InArraySerializer.Owner) )
+	{
+		InArraySerializer.Owner->OnReplicatedMemberChange(Actor, true);
+		bEntered = true;
+	}
+}
+
+void FPolyZone_MemberItem::PreReplicatedRemove(const FPolyZone_MemberArray& InArraySerializer)
+{
+	if( bEntered && IsValid(Actor) && IsValid(InArraySerializer.Owner) )
+	{
+		InArraySerializer.Owner->OnReplicatedMemberChange(Actor, false);
+	}
+	bEntered = false;
+}
+
+// ==================== SERVER ====================
+
+void FPolyZone_MemberArray::AddMember(AActor* Actor)
+{
+	FPolyZone_MemberItem& Item = Items.AddDefaulted_GetRef();
+	Item.Actor = Actor;
+	MarkItemDirty(Item);
+}
+
+void FPolyZone_MemberArray::RemoveMember(AActor* Actor)
+{
+	const int32 Index = Items.IndexOfByPredicate([Actor](const FPolyZone_MemberItem& Item) { return Item.Actor == Actor; });
+	if( Index != INDEX_NONE )
+	{
+		Items.RemoveAtSwap(Index);
+		MarkArrayDirty();
+	}
+}
@@ -0,0 +1,200 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_Sampling.h"
+#include "PolyZone_Shape.h"
+#include "PolyZones_Plugin.h"
+
+namespace
+{
+	constexpr int64 MaxSamplingCells = int64(1) << 22; // 4M cells (16MB of Poisson grid), finer requests are coarsened
+	constexpr int32 PoissonCandidates = 30; // Tries around every active point (Bridson's k)
+}
+
+double FPolyZone_Sampling::ClampSpacing(const FPolyZone_Shape& Shape, double Spacing, double CellsPerSpacing)
+{
+	const FVector2D Size = Shape.BoundsMax - Shape.BoundsMin;
+	const double MinSpacing = CellsPerSpacing * FMath::Sqrt((Size.X * Size.Y) / MaxSamplingCells);
+	if( Spacing < MinSpacing )
+	{
+		UE_LOG(LogPolyZones, Warning, TEXT("PolyZone sampling spacing %.1f is too fine for a %.0f x %.0f zone, using %.1f"), Spacing, Size.X, Size.Y, MinSpacing);
+		return MinSpacing;
+	}
+	return Spacing;
+}
+
+void FPolyZone_Sampling::PoissonDisk(const FPolyZone_Shape& Shape, double MinSpacing, int32 MaxPoints, FRandomStream& Stream, TArray<FVector2D>& OutPoints)
+{
+	OutPoints.Reset();
+	if( Shape.Polygon.Num() < 3 || MinSpacing <= 0.0 )
+	{
+		return;
+	}
+	MaxPoints = MaxPoints > 0 ? MaxPoints : MAX_int32;
+
+	// Cells small enough to hold at most one point, so a neighbour check is the 5x5 block around a cell
+	const double Radius = ClampSpacing(Shape, MinSpacing, FMath::Sqrt(2.0)); // Twice the cells of a Radius grid
+	const double RadiusSquared = Radius * Radius;
+	const double CellSize = Radius / FMath::Sqrt(2.0);
+	const double InvCellSize = 1.0 / CellSize;
+	const FVector2D Origin = Shape.BoundsMin;
+	const int32 CellsX = FMath::Max(1, FMath::CeilToInt32((Shape.BoundsMax.X - Origin.X) * InvCellSize));
+	const int32 CellsY = FMath::Max(1, FMath::CeilToInt32((Shape.BoundsMax.Y - Origin.Y) * InvCellSize));
+
+	TArray<int32> Cells;
+	Cells.Init(INDEX_NONE, CellsX * CellsY);
+	TArray<int32> Active;
+
+	auto GetCell = [&](const FVector2D& Point, int32& OutX, int32& OutY)
+	{
+		OutX = FMath::Clamp(FMath::FloorToInt32((Point.X - Origin.X) * InvCellSize), 0, CellsX - 1);
+		OutY = FMath::Clamp(FMath::FloorToInt32((Point.Y - Origin.Y) * InvCellSize), 0, CellsY - 1);
+	};
+
+	// Cheapest test first, the shape test only runs for candidates with room around them
+	auto CanPlace = [&](const FVector2D& Point)
+	{
+		if( Point.X < Shape.BoundsMin.X || Point.X > Shape.BoundsMax.X || Point.Y < Shape.BoundsMin.Y || Point.Y > Shape.BoundsMax.Y )
+		{
+			return false;
+		}
+
+		int32 CellX, CellY;
+		GetCell(Point, CellX, CellY);
+		for( int32 Y = FMath::Max(0, CellY - 2); Y <= FMath::Min(CellsY - 1, CellY + 2); ++Y )
+		{
+			for( int32 X = FMath::Max(0, CellX - 2); X <= FMath::Min(CellsX - 1, CellX + 2); ++X )
+			{
+				const int32 Other = Cells[X + Y * CellsX];
+				if( Other != INDEX_NONE && FVector2D::DistSquared(OutPoints[Other], Point) < RadiusSquared )
+				{
+					return false;
+				}
+			}
+		}
+		return Shape.IsPointWithinShape(Point);
+	};
+
+	auto Place = [&](const FVector2D& Point)
+	{
+		int32 CellX, CellY;
+		GetCell(Point, CellX, CellY);
+		const int32 PointIndex = OutPoints.Add(Point);
+		Cells[CellX + CellY * CellsX] = PointIndex;
+		Active.Add(PointIndex);
+	};
+
+	// True when one point is close enough to every corner of the cell, nothing can go anywhere in it
+	auto IsCellCovered = [&](int32 CellX, int32 CellY)
+	{
+		const FVector2D CellMin = Origin + FVector2D(CellX, CellY) * CellSize;
+		const FVector2D CellMax = CellMin + FVector2D(CellSize, CellSize);
+		for( int32 Y = FMath::Max(0, CellY - 2); Y <= FMath::Min(CellsY - 1, CellY + 2); ++Y )
+		{
+			for( int32 X = FMath::Max(0, CellX - 2); X <= FMath::Min(CellsX - 1, CellX + 2); ++X )
+			{
+				const int32 Other = Cells[X + Y * CellsX];
+				if( Other == INDEX_NONE )
+				{
+					continue;
+				}
+				const FVector2D& OtherPoint = OutPoints[Other];
+				const double FarX = FMath::Max(FMath::Abs(OtherPoint.X - CellMin.X), FMath::Abs(OtherPoint.X - CellMax.X));
+				const double FarY = FMath::Max(FMath::Abs(OtherPoint.Y - CellMin.Y), FMath::Abs(OtherPoint.Y - CellMax.Y));
+				if( FarX * FarX + FarY * FarY < RadiusSquared )
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	};
+
+	// Seeds come from the empty cells in scan order. Points are only ever added, so a cell that had no room never gets any
+	// and one pass over the grid tries every gap the growth left behind, wherever it is in a concave shape
+	const int32 NumCells = CellsX * CellsY;
+	int32 ScanCell = 0;
+	while( OutPoints.Num() < MaxPoints )
+	{
+		bool Seeded = false;
+		for( ; ScanCell < NumCells && !Seeded; ++ScanCell )
+		{
+			const int32 CellX = ScanCell % CellsX;
+			const int32 CellY = ScanCell / CellsX;
+			if( Cells[ScanCell] != INDEX_NONE || IsCellCovered(CellX, CellY) )
+			{
+				continue;
+			}
+
+			const FVector2D CellMin = Origin + FVector2D(CellX, CellY) * CellSize;
+			for( int32 Try = 0; Try < PoissonCandidates && !Seeded; ++Try )
+			{
+				const FVector2D Seed = CellMin + FVector2D(Stream.GetFraction(), Stream.GetFraction()) * CellSize;
+				if( CanPlace(Seed) )
+				{
+					Place(Seed);
+					Seeded = true;
+				}
+			}
+		}
+		if( !Seeded )
+		{
+			break; // Every cell is full, covered or had no room inside the shape
+		}
+
+		while( Active.Num() > 0 && OutPoints.Num() < MaxPoints )
+		{
+			const int32 ActiveIndex = Stream.RandHelper(Active.Num());
+			const FVector2D Center = OutPoints[Active[ActiveIndex]];
+
+			bool Found = false;
+			for( int32 Try = 0; Try < PoissonCandidates; ++Try )
+			{
+				// Uniform by area over the annulus from Radius to 2 * Radius
+				const double Distance = Radius * FMath::Sqrt(1.0 + 3.0 * Stream.GetFraction());
+				const double Angle = Stream.GetFraction() * 2.0 * PI;
+				const FVector2D Candidate = Center + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Distance;
+				if( CanPlace(Candidate) )
+				{
+					Place(Candidate);
+					Found = true;
+					break;
+				}
+			}
+			if( !Found )
+			{
+				Active.RemoveAtSwap(ActiveIndex, 1, false);
+			}
+		}
+		Active.Reset();
+	}
+}
+
+void FPolyZone_Sampling::Stratified(const FPolyZone_Shape& Shape, double Spacing, float Jitter, FRandomStream& Stream, TArray<FVector2D>& OutPoints)
+{
+	OutPoints.Reset();
+	if( Shape.Polygon.Num() < 3 || Spacing <= 0.0 )
+	{
+		return;
+	}
+
+	Spacing = ClampSpacing(Shape, Spacing, 1.0);
+	const double JitterExtent = FMath::Clamp(Jitter, 0.0f, 1.0f) * Spacing * 0.5;
+	const int32 CellsX = FMath::Max(1, FMath::CeilToInt32((Shape.BoundsMax.X - Shape.BoundsMin.X) / Spacing));
+	const int32 CellsY = FMath::Max(1, FMath::CeilToInt32((Shape.BoundsMax.Y - Shape.BoundsMin.Y) / Spacing));
+
+	// Center the cells on the bounds, so the gaps at the borders match on both sides
+	const FVector2D Origin = (Shape.BoundsMin + Shape.BoundsMax) * 0.5 - FVector2D(CellsX, CellsY) * (Spacing * 0.5);
+	OutPoints.Reserve(CellsX * CellsY);
+	for( int32 Y = 0; Y < CellsY; ++Y )
+	{
+		for( int32 X = 0; X < CellsX; ++X )
+		{
+			const FVector2D Center = Origin + FVector2D(X + 0.5, Y + 0.5) * Spacing;
+			const FVector2D Point = Center + FVector2D(Stream.FRandRange(-JitterExtent, JitterExtent), Stream.FRandRange(-JitterExtent, JitterExtent));
+			if( Shape.IsPointWithinShape(Point) )
+			{
+				OutPoints.Add(Point);
+			}
+		}
+	}
+}
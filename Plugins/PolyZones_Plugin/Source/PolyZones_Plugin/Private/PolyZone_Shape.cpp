@@ -0,0 +1,947 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_Shape.h"
+#include "PolyZone_Stats.h"
+#include "PolyZones_Plugin.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Reverse.h"
+#include "Misc/ScopeLock.h"
+
+namespace
+{
+	// Vertices closer than this are treated as the same when sharing shapes, soaks up float noise from the actor transform
+	constexpr double ShapeMatchTolerance = 0.01;
+
+	// Multipliers to get each corner of a cell from its center
+	const FVector2D CellCornerDirections[] = {
+		FVector2D(-1.0f, -1.0f), // BL
+		FVector2D(1.0f, -1.0f), // TL
+		FVector2D(1.0f, 1.0f), // TR
+		FVector2D(-1.0f, 1.0f) // BR
+	};
+
+	struct FShapeCacheEntry
+	{
+		TArray<FVector2D> SourcePolygon;
+		FPolyZone_ShapeSettings Settings;
+		TWeakPtr<const FPolyZone_Shape, ESPMode::ThreadSafe> Shape;
+	};
+
+	struct FShapeCache
+	{
+		FCriticalSection Lock;
+		TMultiMap<uint32, FShapeCacheEntry> Entries;
+		int32 InsertionsSincePrune = 0;
+
+		static FShapeCache& Get()
+		{
+			static FShapeCache Cache;
+			return Cache;
+		}
+	};
+
+	uint32 HashSourcePolygon(const TArray<FVector2D>& Polygon, const FPolyZone_ShapeSettings& Settings)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Settings), GetTypeHash(Polygon.Num()));
+		for( const FVector2D& Point : Polygon )
+		{
+			Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt64(Point.X / ShapeMatchTolerance)));
+			Hash = HashCombine(Hash, GetTypeHash(FMath::RoundToInt64(Point.Y / ShapeMatchTolerance)));
+		}
+		return Hash;
+	}
+
+	// Rounds towards negative infinity, Divisor must be positive
+	FORCEINLINE int64 FloorDiv(int64 Value, int64 Divisor)
+	{
+		return Value >= 0 ? Value / Divisor : -((-Value + Divisor - 1) / Divisor);
+	}
+
+	bool SourcePolygonsMatch(const TArray<FVector2D>& A, const TArray<FVector2D>& B)
+	{
+		if( A.Num() != B.Num() )
+		{
+			return false;
+		}
+		for( int32 i = 0; i < A.Num(); ++i )
+		{
+			if( !A[i].Equals(B[i], ShapeMatchTolerance) )
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// Must be called with the cache lock held
+	FPolyZone_ShapePtr FindCachedShape(FShapeCache& Cache, uint32 Hash, const TArray<FVector2D>& SourcePolygon, const FPolyZone_ShapeSettings& Settings)
+	{
+		for( auto It = Cache.Entries.CreateKeyIterator(Hash); It; ++It )
+		{
+			FPolyZone_ShapePtr Shape = It.Value().Shape.Pin();
+			if( !Shape.IsValid() )
+			{
+				It.RemoveCurrent(); // Every zone using it is gone
+				continue;
+			}
+			if( It.Value().Settings == Settings && SourcePolygonsMatch(It.Value().SourcePolygon, SourcePolygon) )
+			{
+				return Shape;
+			}
+		}
+		return nullptr;
+	}
+}
+
+// ==================== FRAME ====================
+
+FPolyZone_Frame FPolyZone_Frame::FromTransform(const FTransform& Transform)
+{
+	FPolyZone_Frame Frame;
+	Frame.Origin = Transform.GetLocation();
+
+	// Only yaw matters, zones are always flat
+	const FVector Forward = Transform.GetRotation().GetForwardVector();
+	const FVector2D Forward2D(Forward.X, Forward.Y);
+	Frame.AxisX = Forward2D.IsNearlyZero() ? FVector2D(1.0, 0.0) : Forward2D.GetSafeNormal();
+
+	Frame.Scale = FMath::Max<double>(Transform.GetMaximumAxisScale(), KINDA_SMALL_NUMBER);
+	Frame.InvScale = 1.0 / Frame.Scale;
+	return Frame;
+}
+
+FQuat FPolyZone_Frame::GetRotation() const
+{
+	return FQuat(FVector::UpVector, FMath::Atan2(AxisX.Y, AxisX.X));
+}
+
+// ==================== CACHE ====================
+
+TSharedRef<const FPolyZone_Shape, ESPMode::ThreadSafe> FPolyZone_Shape::FindOrBuild(const TArray<FVector2D>& SourcePolygon, const FPolyZone_ShapeSettings& Settings,
+	const FPolyZone_Shape* PreviousShape, TConstArrayView<POLYZONE_CELL_FLAGS> BakedGridData)
+{
+	FShapeCache& Cache = FShapeCache::Get();
+	const uint32 Hash = HashSourcePolygon(SourcePolygon, Settings);
+
+	{
+		FScopeLock ScopeLock(&Cache.Lock);
+		if( FPolyZone_ShapePtr CachedShape = FindCachedShape(Cache, Hash, SourcePolygon, Settings) )
+		{
+			return CachedShape.ToSharedRef();
+		}
+	}
+
+	// Build outside the lock, other zones can keep constructing meanwhile
+	TSharedRef<const FPolyZone_Shape, ESPMode::ThreadSafe> NewShape = BuildUncached(SourcePolygon, Settings, PreviousShape, BakedGridData);
+
+	FScopeLock ScopeLock(&Cache.Lock);
+	if( FPolyZone_ShapePtr CachedShape = FindCachedShape(Cache, Hash, SourcePolygon, Settings) )
+	{
+		return CachedShape.ToSharedRef(); // Someone else built the same shape while we were building
+	}
+
+	// Occasionally drop entries whose shapes are gone, so the cache doesn't hold on to their source polygons
+	if( ++Cache.InsertionsSincePrune >= 64 )
+	{
+		Cache.InsertionsSincePrune = 0;
+		for( auto It = Cache.Entries.CreateIterator(); It; ++It )
+		{
+			if( !It.Value().Shape.IsValid() )
+			{
+				It.RemoveCurrent();
+			}
+		}
+	}
+
+	FShapeCacheEntry& Entry = Cache.Entries.Add(Hash, FShapeCacheEntry());
+	Entry.SourcePolygon = SourcePolygon;
+	Entry.Settings = Settings;
+	Entry.Shape = NewShape;
+	return NewShape;
+}
+
+TSharedRef<const FPolyZone_Shape, ESPMode::ThreadSafe> FPolyZone_Shape::BuildUncached(const TArray<FVector2D>& SourcePolygon, const FPolyZone_ShapeSettings& Settings,
+	const FPolyZone_Shape* PreviousShape, TConstArrayView<POLYZONE_CELL_FLAGS> BakedGridData)
+{
+	TSharedRef<FPolyZone_Shape, ESPMode::ThreadSafe> NewShape = MakeShared<FPolyZone_Shape, ESPMode::ThreadSafe>();
+	NewShape->Build(SourcePolygon, Settings, PreviousShape, BakedGridData);
+
+	INC_DWORD_STAT(STAT_PolyZone_Shapes);
+	INC_MEMORY_STAT_BY(STAT_PolyZone_ShapeMemory, NewShape->GetAllocatedSize());
+	return NewShape;
+}
+
+FPolyZone_Shape::~FPolyZone_Shape()
+{
+	// Shapes are immutable once built, so this matches what BuildUncached added
+	DEC_DWORD_STAT(STAT_PolyZone_Shapes);
+	DEC_MEMORY_STAT_BY(STAT_PolyZone_ShapeMemory, GetAllocatedSize());
+}
+
+uint32 FPolyZone_Shape::GetSourceHash(const TArray<FVector2D>& SourcePolygon, const FPolyZone_ShapeSettings& Settings)
+{
+	return HashSourcePolygon(SourcePolygon, Settings);
+}
+
+int32 FPolyZone_Shape::GetNumCachedShapes()
+{
+	FShapeCache& Cache = FShapeCache::Get();
+	FScopeLock ScopeLock(&Cache.Lock);
+
+	int32 NumAlive = 0;
+	for( const TPair<uint32, FShapeCacheEntry>& Entry : Cache.Entries )
+	{
+		NumAlive += Entry.Value.Shape.IsValid() ? 1 : 0;
+	}
+	return NumAlive;
+}
+
+// ==================== BUILD ====================
+
+void FPolyZone_Shape::Build(const TArray<FVector2D>& SourcePolygon, const FPolyZone_ShapeSettings& Settings, const FPolyZone_Shape* PreviousShape,
+	TConstArrayView<POLYZONE_CELL_FLAGS> BakedGridData)
+{
+	Polygon = SourcePolygon;
+	SourceVertexCount = SourcePolygon.Num();
+	if( Polygon.Num() < 3 )
+	{
+		return; // Not a polygon, every query will fail
+	}
+
+	FPolyZone_Geometry::SimplifyPolygon(Polygon, Settings.SimplifyMode, Settings.SimplifyTolerance);
+
+	// Save calculated bounds to save cpu cycles in PolyZone test
+	BoundsMin = Polygon[0];
+	BoundsMax = Polygon[0];
+	for( const FVector2D& Point : Polygon )
+	{
+		BoundsMin = FVector2D::Min(BoundsMin, Point);
+		BoundsMax = FVector2D::Max(BoundsMax, Point);
+	}
+	Build_Edges();
+
+	if( Settings.bRobustPredicates && Build_FixedPoint() )
+	{
+		QueryPath = POLYZONE_QUERY_PATH::FixedPoint; // Every query goes through the integer tests, the floating point paths are never used
+	}
+	else
+	{
+		Build_QueryPath(Settings);
+	}
+	Build_Grid(PreviousShape, BakedGridData);
+	Build_Components();
+}
+
+// Prefix sums of the edge lengths, so edge sampling is a binary search instead of a walk along the spline
+void FPolyZone_Shape::Build_Edges()
+{
+	EdgeDistances.Reset(Polygon.Num() + 1);
+	double Distance = 0.0;
+	for( int32 i = 0; i < Polygon.Num(); ++i )
+	{
+		EdgeDistances.Add(Distance);
+		Distance += FVector2D::Distance(Polygon[i], Polygon[(i + 1) % Polygon.Num()]);
+	}
+	EdgeDistances.Add(Distance);
+
+	OutwardSign = FPolyZone_Geometry::SignedArea(Polygon) >= 0.0 ? 1.0 : -1.0;
+}
+
+FVector2D FPolyZone_Shape::GetPointAlongEdges(double Distance, int32& OutEdgeIndex, FVector2D& OutNormal) const
+{
+	const double Perimeter = GetPerimeter();
+	if( Perimeter <= 0.0 )
+	{
+		OutEdgeIndex = INDEX_NONE;
+		OutNormal = FVector2D::ZeroVector;
+		return Polygon.Num() > 0 ? Polygon[0] : FVector2D::ZeroVector;
+	}
+
+	Distance = FMath::Fmod(Distance, Perimeter);
+	if( Distance < 0.0 )
+	{
+		Distance += Perimeter;
+	}
+
+	// Last edge starting at or before the distance, zero length edges are skipped because the next edge starts at the same distance
+	const int32 NumEdges = Polygon.Num();
+	OutEdgeIndex = FMath::Clamp(Algo::UpperBound(TConstArrayView<double>(EdgeDistances.GetData(), NumEdges), Distance) - 1, 0, NumEdges - 1);
+
+	const FVector2D& Start = Polygon[OutEdgeIndex];
+	const FVector2D& End = Polygon[(OutEdgeIndex + 1) % NumEdges];
+	const double EdgeLength = EdgeDistances[OutEdgeIndex + 1] - EdgeDistances[OutEdgeIndex];
+	const FVector2D Direction = EdgeLength > 0.0 ? (End - Start) / EdgeLength : FVector2D::ZeroVector;
+	OutNormal = FVector2D(Direction.Y, -Direction.X) * OutwardSign;
+	return Start + Direction * FMath::Min(Distance - EdgeDistances[OutEdgeIndex], EdgeLength);
+}
+
+// Snaps the polygon to the fixed point grid, fails if the zone is too large for exact int64 math
+bool FPolyZone_Shape::Build_FixedPoint()
+{
+	FixedPolygon.Reset(Polygon.Num());
+	for( const FVector2D& Point : Polygon )
+	{
+		const FPolyZone_FixedPoint FixedPoint = FPolyZone_Geometry::ToFixedPoint(Point);
+		if( FMath::Abs(FixedPoint.X) > FPolyZone_Geometry::FixedPointMaxCoord || FMath::Abs(FixedPoint.Y) > FPolyZone_Geometry::FixedPointMaxCoord )
+		{
+			UE_LOG(LogPolyZones, Warning, TEXT("PolyZone is too large for robust predicates (%.0f cm from its origin), using floating point tests instead"),
+				FMath::Max(FMath::Abs(Point.X), FMath::Abs(Point.Y)));
+			FixedPolygon.Empty();
+			return false;
+		}
+		if( FixedPolygon.Num() == 0 || !(FixedPolygon.Last() == FixedPoint) )
+		{
+			FixedPolygon.Add(FixedPoint); // Snapping can merge vertices that were very close
+		}
+	}
+	while( FixedPolygon.Num() > 1 && FixedPolygon.Last() == FixedPolygon[0] )
+	{
+		FixedPolygon.Pop();
+	}
+	if( FixedPolygon.Num() < 3 )
+	{
+		FixedPolygon.Empty();
+		return false;
+	}
+
+	FixedBoundsMin = FixedPolygon[0];
+	FixedBoundsMax = FixedPolygon[0];
+	for( const FPolyZone_FixedPoint& FixedPoint : FixedPolygon )
+	{
+		FixedBoundsMin.X = FMath::Min(FixedBoundsMin.X, FixedPoint.X);
+		FixedBoundsMin.Y = FMath::Min(FixedBoundsMin.Y, FixedPoint.Y);
+		FixedBoundsMax.X = FMath::Max(FixedBoundsMax.X, FixedPoint.X);
+		FixedBoundsMax.Y = FMath::Max(FixedBoundsMax.Y, FixedPoint.Y);
+	}
+	return true;
+}
+
+// Picks the cheapest point in polygon test for this shape
+void FPolyZone_Shape::Build_QueryPath(const FPolyZone_ShapeSettings& Settings)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_BuildQueryPath);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPolyZone_Shape::Build_QueryPath);
+
+	QueryPath = POLYZONE_QUERY_PATH::Polygon;
+	ConvexPolygon.Empty();
+	ConvexPieces.Empty();
+
+	if( FPolyZone_Geometry::IsConvex(Polygon) )
+	{
+		ConvexPolygon = Polygon;
+		if( FPolyZone_Geometry::SignedArea(ConvexPolygon) < 0.0 )
+		{
+			Algo::Reverse(ConvexPolygon); // The wedge search expects counter-clockwise
+		}
+		QueryPath = POLYZONE_QUERY_PATH::Convex;
+	}
+	else if( Settings.bDecomposeConcave )
+	{
+		if( FPolyZone_Geometry::DecomposeConvex(Polygon, ConvexPieces) && ConvexPieces.Num() <= Settings.MaxConvexPieces )
+		{
+			QueryPath = POLYZONE_QUERY_PATH::ConvexPieces;
+		}
+		else
+		{
+			ConvexPieces.Empty();
+		}
+	}
+}
+
+void FPolyZone_Shape::Build_Grid(const FPolyZone_Shape* PreviousShape, TConstArrayView<POLYZONE_CELL_FLAGS> BakedGridData)
+{
+	SCOPE_CYCLE_COUNTER(STAT_PolyZone_BuildGrid);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPolyZone_Shape::Build_Grid);
+
+	GridData.Empty();
+
+	const int32 NumPoints = Polygon.Num();
+	UsesGrid = (NumPoints >= 6);
+	if( UsesGrid )
+	{
+		// Calculate a performant cell size
+		const double DesiredCellCount = FMath::Min(40.0, 2.0 * NumPoints);
+		const FVector2D BoundsSize = BoundsMax - BoundsMin;
+		const double DistanceToCover = FMath::Max(BoundsSize.X, BoundsSize.Y);
+		CellSize = DistanceToCover / DesiredCellCount;
+		if( CellSize <= KINDA_SMALL_NUMBER )
+		{
+			UsesGrid = false; // Degenerate polygon
+			return;
+		}
+
+		if( QueryPath == POLYZONE_QUERY_PATH::FixedPoint )
+		{
+			// Snap the grid to whole fixed point units, so cell lookups are integer divisions
+			FixedCellSize = FMath::Max<int64>(1, FMath::RoundToInt64(CellSize * FPolyZone_Geometry::FixedPointScale));
+			FixedGridOrigin.X = FloorDiv(FixedBoundsMin.X, FixedCellSize) * FixedCellSize;
+			FixedGridOrigin.Y = FloorDiv(FixedBoundsMin.Y, FixedCellSize) * FixedCellSize;
+			GridCellsX = static_cast<int32>((FixedBoundsMax.X - FixedGridOrigin.X) / FixedCellSize) + 1;
+			GridCellsY = static_cast<int32>((FixedBoundsMax.Y - FixedGridOrigin.Y) / FixedCellSize) + 1;
+
+			// Floating point copies for blueprints and debug drawing
+			CellSize = FixedCellSize / FPolyZone_Geometry::FixedPointScale;
+			GridOrigin = FPolyZone_Geometry::FromFixedPoint(FixedGridOrigin);
+			InvCellSize = 1.0 / CellSize;
+		}
+		else
+		{
+			InvCellSize = 1.0 / CellSize;
+
+			// Find the cell (local grid) for the bottom left bounds, and make it our grid origin
+			GridOrigin.X = FMath::FloorToDouble(BoundsMin.X / CellSize) * CellSize;
+			GridOrigin.Y = FMath::FloorToDouble(BoundsMin.Y / CellSize) * CellSize;
+
+			const double DistanceX = BoundsMax.X - GridOrigin.X;
+			const double DistanceY = BoundsMax.Y - GridOrigin.Y;
+
+			// Find how many cells we will need to cover the polygon
+			GridCellsX = FMath::Max(1, FMath::CeilToInt(DistanceX / CellSize));
+			GridCellsY = FMath::Max(1, FMath::CeilToInt(DistanceY / CellSize));
+		}
+
+		const int32 TotalCells = GridCellsX * GridCellsY;
+		int32 MinGridX = 0;
+		int32 MinGridY = 0;
+		int32 MaxGridX = GridCellsX - 1;
+		int32 MaxGridY = GridCellsY - 1;
+
+		// Dragging a spline point only changes the cells around its two edges, the rest of the grid can be copied as long as the layout matches
+		FBox2D ChangedBounds;
+		if( BakedGridData.Num() == TotalCells )
+		{
+			GridData.Append(BakedGridData.GetData(), BakedGridData.Num()); // Tested when the level was saved
+			MaxGridX = -1;
+		}
+		else if( PreviousShape && CanReuseGrid(*PreviousShape) && GetChangedBounds(*PreviousShape, ChangedBounds) )
+		{
+			GridData = PreviousShape->GridData;
+			if( ChangedBounds.bIsValid )
+			{
+				// One cell of margin, cell tests include their boundary
+				MinGridX = FMath::Max(0, FMath::FloorToInt32((ChangedBounds.Min.X - GridOrigin.X) * InvCellSize) - 1);
+				MinGridY = FMath::Max(0, FMath::FloorToInt32((ChangedBounds.Min.Y - GridOrigin.Y) * InvCellSize) - 1);
+				MaxGridX = FMath::Min(GridCellsX - 1, FMath::FloorToInt32((ChangedBounds.Max.X - GridOrigin.X) * InvCellSize) + 1);
+				MaxGridY = FMath::Min(GridCellsY - 1, FMath::FloorToInt32((ChangedBounds.Max.Y - GridOrigin.Y) * InvCellSize) + 1);
+			}
+			else
+			{
+				MaxGridX = -1; // Nothing moved, keep every cell
+			}
+		}
+		else
+		{
+			GridData.Init(POLYZONE_CELL_FLAGS::Outside, TotalCells);
+		}
+
+		// Populate grid data
+		for( int32 GridX = MinGridX; GridX <= MaxGridX; GridX++ )
+		{
+			for( int32 GridY = MinGridY; GridY <= MaxGridY; GridY++ )
+			{
+				FPolyZone_GridCell NewCell = FPolyZone_GridCell(GridX, GridY);
+				POLYZONE_CELL_FLAGS FlagForNewCell = (QueryPath == POLYZONE_QUERY_PATH::FixedPoint) ? TestCellAgainstPolygon_Fixed(NewCell) : TestCellAgainstPolygon(NewCell);
+				const int32 CellIndex = GetGridCellIndex(NewCell);
+				if( CellIndex != INDEX_NONE )
+				{
+					GridData[CellIndex] = FlagForNewCell;
+				}
+			}
+		}
+	}
+}
+
+bool FPolyZone_Shape::CanReuseGrid(const FPolyZone_Shape& PreviousShape) const
+{
+	if( !PreviousShape.UsesGrid || PreviousShape.QueryPath != QueryPath || PreviousShape.GridCellsX != GridCellsX || PreviousShape.GridCellsY != GridCellsY ||
+		PreviousShape.CellSize != CellSize || PreviousShape.GridOrigin != GridOrigin || PreviousShape.GridData.Num() != GridCellsX * GridCellsY )
+	{
+		return false;
+	}
+	return QueryPath != POLYZONE_QUERY_PATH::FixedPoint || (PreviousShape.FixedCellSize == FixedCellSize && PreviousShape.FixedGridOrigin == FixedGridOrigin);
+}
+
+// Bounds of every edge that moved (old and new position), the area between the two polygons lies inside it
+// Returns false when the polygons can't be compared vertex by vertex, the bounds are left invalid when nothing moved
+bool FPolyZone_Shape::GetChangedBounds(const FPolyZone_Shape& PreviousShape, FBox2D& OutChangedBounds) const
+{
+	const int32 NumPoints = Polygon.Num();
+	if( PreviousShape.Polygon.Num() != NumPoints )
+	{
+		return false;
+	}
+
+	OutChangedBounds.Init();
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		if( Polygon[i] != PreviousShape.Polygon[i] )
+		{
+			const int32 Prev = (i + NumPoints - 1) % NumPoints;
+			const int32 Next = (i + 1) % NumPoints;
+			for( const TArray<FVector2D>* Points : { &Polygon, &PreviousShape.Polygon } )
+			{
+				OutChangedBounds += (*Points)[Prev];
+				OutChangedBounds += (*Points)[i];
+				OutChangedBounds += (*Points)[Next];
+			}
+		}
+	}
+	return true;
+}
+
+// Labels every island of Within cells once, so grid searches can tell two cells are unreachable without searching
+void FPolyZone_Shape::Build_Components()
+{
+	CellComponents.Init(INDEX_NONE, GridData.Num());
+	NumComponents = 0;
+
+	TArray<int32> Stack;
+	for( int32 SeedIndex = 0; SeedIndex < GridData.Num(); ++SeedIndex )
+	{
+		if( GridData[SeedIndex] != POLYZONE_CELL_FLAGS::Within || CellComponents[SeedIndex] != INDEX_NONE )
+		{
+			continue;
+		}
+
+		const int32 Component = NumComponents++;
+		CellComponents[SeedIndex] = Component;
+		Stack.Add(SeedIndex);
+		while( Stack.Num() > 0 )
+		{
+			const int32 CellIndex = Stack.Pop(false);
+			const int32 X = CellIndex % GridCellsX;
+			const int32 Y = CellIndex / GridCellsX;
+			const int32 Neighbours[] = { X > 0 ? CellIndex - 1 : INDEX_NONE, X < GridCellsX - 1 ? CellIndex + 1 : INDEX_NONE,
+				Y > 0 ? CellIndex - GridCellsX : INDEX_NONE, Y < GridCellsY - 1 ? CellIndex + GridCellsX : INDEX_NONE };
+			for( const int32 Neighbour : Neighbours )
+			{
+				if( Neighbour != INDEX_NONE && GridData[Neighbour] == POLYZONE_CELL_FLAGS::Within && CellComponents[Neighbour] == INDEX_NONE )
+				{
+					CellComponents[Neighbour] = Component;
+					Stack.Add(Neighbour);
+				}
+			}
+		}
+	}
+}
+
+POLYZONE_CELL_FLAGS FPolyZone_Shape::TestCellAgainstPolygon(const FPolyZone_GridCell& Cell) const
+{
+	const double HalfCellSize = CellSize * 0.5;
+	const FVector2D CellCenter = GetGridCellLocal(Cell) + FVector2D(HalfCellSize, HalfCellSize);
+	const FVector2D CellMin(CellCenter.X - HalfCellSize, CellCenter.Y - HalfCellSize);
+	const FVector2D CellMax(CellCenter.X + HalfCellSize, CellCenter.Y + HalfCellSize);
+
+	int Corner = -1;
+	bool Result = false;
+	bool OnPolyEdge = false;
+	for( const FVector2D& CornerDir : CellCornerDirections )
+	{
+		FVector2D CellCorner;
+		CellCorner.X = CellCenter.X + HalfCellSize * CornerDir.X;
+		CellCorner.Y = CellCenter.Y + HalfCellSize * CornerDir.Y;
+
+		bool CurResult = IsPointWithinPolygon(CellCorner);
+
+		Corner++;
+		if( Corner == 0 ) // First test
+		{
+			Result = CurResult;
+		}
+		else
+		{
+			if( CurResult != Result )
+			{
+				OnPolyEdge = true;
+				break;
+			}
+		}
+	}
+
+	if( OnPolyEdge )
+	{
+		return POLYZONE_CELL_FLAGS::OnEdge;
+	}
+	if( Result )
+	{
+		return POLYZONE_CELL_FLAGS::Within;
+	}
+
+	// Any polygon vertex inside the cell?
+	const int32 NumPoints = Polygon.Num();
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		if( FPolyZone_Geometry::IsPointInAABB_2D(Polygon[i], CellMin, CellMax) )
+		{
+			return POLYZONE_CELL_FLAGS::OnEdge;
+		}
+	}
+
+	// Any polygon edge intersects any cell edge?
+	const FVector2D CellTL(CellMin.X, CellMax.Y);
+	const FVector2D CellTR(CellMax.X, CellMax.Y);
+	const FVector2D CellBR(CellMax.X, CellMin.Y);
+	const FVector2D CellBL(CellMin.X, CellMin.Y);
+
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		const FVector2D& A = Polygon[i];
+		const FVector2D& B = Polygon[(i + 1) % NumPoints];
+
+		if( FPolyZone_Geometry::SegmentsIntersect2D(A, B, CellTL, CellTR) || FPolyZone_Geometry::SegmentsIntersect2D(A, B, CellTR, CellBR) ||
+			FPolyZone_Geometry::SegmentsIntersect2D(A, B, CellBR, CellBL) || FPolyZone_Geometry::SegmentsIntersect2D(A, B, CellBL, CellTL) )
+		{
+			return POLYZONE_CELL_FLAGS::OnEdge;
+		}
+	}
+
+	return POLYZONE_CELL_FLAGS::Outside;
+}
+
+POLYZONE_CELL_FLAGS FPolyZone_Shape::TestCellAgainstPolygon_Fixed(const FPolyZone_GridCell& Cell) const
+{
+	FPolyZone_FixedPoint CellMin;
+	CellMin.X = FixedGridOrigin.X + Cell.X * FixedCellSize;
+	CellMin.Y = FixedGridOrigin.Y + Cell.Y * FixedCellSize;
+	FPolyZone_FixedPoint CellMax;
+	CellMax.X = CellMin.X + FixedCellSize;
+	CellMax.Y = CellMin.Y + FixedCellSize;
+
+	FPolyZone_FixedPoint Corners[4] = { CellMin, CellMin, CellMax, CellMax };
+	Corners[1].X = CellMax.X; // BR
+	Corners[3].X = CellMin.X; // TL
+
+	const bool FirstInside = FPolyZone_Geometry::IsPointInPolygon_Fixed(FixedPolygon, Corners[0]);
+	for( int32 Corner = 1; Corner < 4; ++Corner )
+	{
+		if( FPolyZone_Geometry::IsPointInPolygon_Fixed(FixedPolygon, Corners[Corner]) != FirstInside )
+		{
+			return POLYZONE_CELL_FLAGS::OnEdge;
+		}
+	}
+
+	// Even with every corner inside, a notch of the polygon can still reach into the cell
+	const int32 NumPoints = FixedPolygon.Num();
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		const FPolyZone_FixedPoint& A = FixedPolygon[i];
+		if( A.X >= CellMin.X && A.X <= CellMax.X && A.Y >= CellMin.Y && A.Y <= CellMax.Y )
+		{
+			return POLYZONE_CELL_FLAGS::OnEdge;
+		}
+
+		const FPolyZone_FixedPoint& B = FixedPolygon[(i + 1) % NumPoints];
+		for( int32 Corner = 0; Corner < 4; ++Corner )
+		{
+			if( FPolyZone_Geometry::SegmentsIntersect_Fixed(A, B, Corners[Corner], Corners[(Corner + 1) % 4]) )
+			{
+				return POLYZONE_CELL_FLAGS::OnEdge;
+			}
+		}
+	}
+
+	return FirstInside ? POLYZONE_CELL_FLAGS::Within : POLYZONE_CELL_FLAGS::Outside;
+}
+
+// ==================== QUERIES ====================
+
+bool FPolyZone_Shape::IsPointWithinShape(const FVector2D& LocalPoint) const
+{
+	if( QueryPath == POLYZONE_QUERY_PATH::FixedPoint )
+	{
+		return IsPointWithinShape_Fixed(FPolyZone_Geometry::ToFixedPoint(LocalPoint));
+	}
+
+	// 2D Bounds Check
+	if( LocalPoint.X < BoundsMin.X || LocalPoint.X > BoundsMax.X || LocalPoint.Y < BoundsMin.Y || LocalPoint.Y > BoundsMax.Y )
+	{
+		return false;
+	}
+
+	// Grid check
+	if( UsesGrid )
+	{
+		POLYZONE_CELL_FLAGS CellFlag = GetCellFlagAtLocal(LocalPoint);
+		if( CellFlag == POLYZONE_CELL_FLAGS::Outside )
+		{
+			return false;
+		}
+		if( CellFlag == POLYZONE_CELL_FLAGS::Within )
+		{
+			return true;
+		}
+	}
+
+	return IsPointWithinPolygon(LocalPoint);
+}
+
+bool FPolyZone_Shape::IsPointWithinShape_Fixed(const FPolyZone_FixedPoint& FixedPoint) const
+{
+	if( FixedPoint.X < FixedBoundsMin.X || FixedPoint.X > FixedBoundsMax.X || FixedPoint.Y < FixedBoundsMin.Y || FixedPoint.Y > FixedBoundsMax.Y )
+	{
+		return false;
+	}
+
+	if( UsesGrid )
+	{
+		const POLYZONE_CELL_FLAGS CellFlag = GetCellFlagAtFixed(FixedPoint);
+		if( CellFlag == POLYZONE_CELL_FLAGS::Outside )
+		{
+			return false;
+		}
+		if( CellFlag == POLYZONE_CELL_FLAGS::Within )
+		{
+			return true;
+		}
+	}
+
+	return FPolyZone_Geometry::IsPointInPolygon_Fixed(FixedPolygon, FixedPoint);
+}
+
+void FPolyZone_Shape::ArePointsWithinShape(TConstArrayView<FVector2D> LocalPoints, TArrayView<bool> OutResults) const
+{
+	const int32 NumPoints = LocalPoints.Num();
+	check(OutResults.Num() == NumPoints);
+	if( !UsesGrid || QueryPath == POLYZONE_QUERY_PATH::FixedPoint )
+	{
+		for( int32 i = 0; i < NumPoints; ++i )
+		{
+			OutResults[i] = IsPointWithinShape(LocalPoints[i]);
+		}
+		return;
+	}
+
+	// Resolve everything the grid can answer in one pass, then fall back to the polygon for the rest
+	TArray<POLYZONE_CELL_FLAGS, TInlineAllocator<256>> Flags;
+	Flags.SetNumUninitialized(NumPoints);
+	GetCellFlagsAtLocal(LocalPoints, Flags);
+
+	int32 NumWithin = 0;
+	int32 NumOnEdge = 0;
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		const POLYZONE_CELL_FLAGS CellFlag = Flags[i];
+		if( CellFlag == POLYZONE_CELL_FLAGS::OnEdge )
+		{
+			OutResults[i] = IsPointWithinPolygon(LocalPoints[i]);
+			NumOnEdge++;
+		}
+		else
+		{
+			OutResults[i] = (CellFlag == POLYZONE_CELL_FLAGS::Within);
+			NumWithin += OutResults[i] ? 1 : 0;
+		}
+	}
+
+	INC_DWORD_STAT_BY(STAT_PolyZone_GridWithin, NumWithin);
+	INC_DWORD_STAT_BY(STAT_PolyZone_GridOnEdge, NumOnEdge);
+	INC_DWORD_STAT_BY(STAT_PolyZone_GridOutside, NumPoints - NumWithin - NumOnEdge); // Includes the bounds rejects
+	INC_DWORD_STAT_BY(STAT_PolyZone_PolygonTests, NumOnEdge);
+}
+
+bool FPolyZone_Shape::IsPointWithinPolygon(const FVector2D& LocalPoint) const
+{
+	if( QueryPath == POLYZONE_QUERY_PATH::FixedPoint )
+	{
+		return FPolyZone_Geometry::IsPointInPolygon_Fixed(FixedPolygon, FPolyZone_Geometry::ToFixedPoint(LocalPoint));
+	}
+	if( QueryPath == POLYZONE_QUERY_PATH::Convex )
+	{
+		return FPolyZone_Geometry::IsPointInConvexPolygon(ConvexPolygon, LocalPoint);
+	}
+	if( QueryPath == POLYZONE_QUERY_PATH::ConvexPieces )
+	{
+		for( const FPolyZone_ConvexPiece& Piece : ConvexPieces )
+		{
+			if( FPolyZone_Geometry::IsPointInAABB_2D(LocalPoint, Piece.Min, Piece.Max) && FPolyZone_Geometry::IsPointInConvexPolygon(Piece.Points, LocalPoint) )
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	return IsPointWithinPolygon_PNPoly(LocalPoint);
+}
+
+// Copyright (c) 1970-2003, Wm. Randolph Franklin
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the "Software"),
+// to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish, distribute, sublicense,
+// and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so, subject to the following conditions:
+//
+// 	Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimers.
+// 	Redistributions in binary form must reproduce the above copyright notice in the documentation and/or other materials provided with the distribution.
+// 	The name of W. Randolph Franklin may not be used to endorse or promote products derived from this Software without specific prior written permission.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE
+// OR OTHER DEALINGS IN THE SOFTWARE.
+// Original Code: https://wrfranklin.org/Research/Short_Notes/pnpoly.html
+bool FPolyZone_Shape::IsPointWithinPolygon_PNPoly(const FVector2D& TestPoint) const
+{
+	int NumPoints = Polygon.Num();
+
+	bool InsidePoly = false;
+	for( int i = 0, j = NumPoints - 1; i < NumPoints; j = i++ )
+	{
+		const FVector2D& Point_i = Polygon[i];
+		const FVector2D& Point_j = Polygon[j];
+		if( (Point_i.Y > TestPoint.Y) != (Point_j.Y > TestPoint.Y) &&
+			TestPoint.X < (Point_j.X - Point_i.X) * (TestPoint.Y - Point_i.Y) / (Point_j.Y - Point_i.Y) + Point_i.X )
+		{
+			InsidePoly = !InsidePoly;
+		}
+	}
+
+	return InsidePoly;
+}
+// END MIT LICENSE
+
+void FPolyZone_Shape::GetCellFlagsAtLocal(TConstArrayView<FVector2D> LocalPoints, TArrayView<POLYZONE_CELL_FLAGS> OutFlags) const
+{
+	const int32 NumPoints = LocalPoints.Num();
+	check(OutFlags.Num() == NumPoints);
+	if( !UsesGrid )
+	{
+		FMemory::Memset(OutFlags.GetData(), static_cast<uint8>(POLYZONE_CELL_FLAGS::Outside), NumPoints * sizeof(POLYZONE_CELL_FLAGS));
+		return;
+	}
+	if( QueryPath == POLYZONE_QUERY_PATH::FixedPoint )
+	{
+		for( int32 i = 0; i < NumPoints; ++i )
+		{
+			OutFlags[i] = GetCellFlagAtFixed(FPolyZone_Geometry::ToFixedPoint(LocalPoints[i]));
+		}
+		return;
+	}
+
+	// Hoisted into locals so the loop only touches registers and the flag array
+	const FVector2D* Points = LocalPoints.GetData();
+	POLYZONE_CELL_FLAGS* Flags = OutFlags.GetData();
+	const POLYZONE_CELL_FLAGS* Cells = GridData.GetData();
+	const double OriginX = GridOrigin.X;
+	const double OriginY = GridOrigin.Y;
+	const double Scale = InvCellSize;
+	const uint32 CellsX = static_cast<uint32>(GridCellsX);
+	const uint32 CellsY = static_cast<uint32>(GridCellsY);
+	const FVector2D Min = BoundsMin;
+	const FVector2D Max = BoundsMax;
+
+	for( int32 i = 0; i < NumPoints; ++i )
+	{
+		const FVector2D& Point = Points[i];
+
+		// Clamp before the int conversion, far away points would overflow it
+		const double ClampedX = FMath::Clamp(Point.X, Min.X, Max.X);
+		const double ClampedY = FMath::Clamp(Point.Y, Min.Y, Max.Y);
+		const uint32 GridX = static_cast<uint32>(FMath::FloorToInt32((ClampedX - OriginX) * Scale));
+		const uint32 GridY = static_cast<uint32>(FMath::FloorToInt32((ClampedY - OriginY) * Scale));
+
+		const bool InBounds = (ClampedX == Point.X) & (ClampedY == Point.Y) & (GridX < CellsX) & (GridY < CellsY);
+		Flags[i] = InBounds ? Cells[GridX + GridY * CellsX] : POLYZONE_CELL_FLAGS::Outside;
+	}
+}
+
+POLYZONE_CELL_FLAGS FPolyZone_Shape::GetCellFlagAtFixed(const FPolyZone_FixedPoint& FixedPoint) const
+{
+	if( !UsesGrid || FixedCellSize <= 0 )
+	{
+		return POLYZONE_CELL_FLAGS::Outside;
+	}
+
+	const int64 OffsetX = FixedPoint.X - FixedGridOrigin.X;
+	const int64 OffsetY = FixedPoint.Y - FixedGridOrigin.Y;
+	if( OffsetX < 0 || OffsetY < 0 )
+	{
+		return POLYZONE_CELL_FLAGS::Outside;
+	}
+
+	const int64 GridX = OffsetX / FixedCellSize;
+	const int64 GridY = OffsetY / FixedCellSize;
+	if( GridX >= GridCellsX || GridY >= GridCellsY )
+	{
+		return POLYZONE_CELL_FLAGS::Outside;
+	}
+	return GridData[static_cast<int32>(GridX + GridY * GridCellsX)];
+}
+
+FPolyZone_GridCell FPolyZone_Shape::GetGridCellAtLocation(const FVector2D& LocalPoint) const
+{
+	if( InvCellSize <= 0.0 )
+	{
+		return FPolyZone_GridCell(); // No grid
+	}
+	const FVector2D LocationOnGrid = LocalPoint - GridOrigin;
+	int32 GridX = FMath::FloorToInt(LocationOnGrid.X * InvCellSize);
+	int32 GridY = FMath::FloorToInt(LocationOnGrid.Y * InvCellSize);
+	return FPolyZone_GridCell(GridX, GridY);
+}
+
+int32 FPolyZone_Shape::GetGridCellIndex(const FPolyZone_GridCell& Cell) const
+{
+	if( Cell.X < 0 || Cell.Y < 0 || Cell.X >= GridCellsX || Cell.Y >= GridCellsY )
+	{
+		return INDEX_NONE;
+	}
+
+	return Cell.X + (Cell.Y * GridCellsX);
+}
+
+POLYZONE_CELL_FLAGS FPolyZone_Shape::GetGridCellFlag(const FPolyZone_GridCell& Cell) const
+{
+	const int32 CellIndex = GetGridCellIndex(Cell);
+	if( CellIndex == INDEX_NONE || !GridData.IsValidIndex(CellIndex) )
+	{
+		return POLYZONE_CELL_FLAGS::Outside;
+	}
+
+	return GridData[CellIndex];
+}
+
+FVector2D FPolyZone_Shape::GetGridCellLocal(const FPolyZone_GridCell& Cell) const
+{
+	return GridOrigin + FVector2D(Cell.X * CellSize, Cell.Y * CellSize);
+}
+
+TArray<FPolyZone_GridCell> FPolyZone_Shape::GetAllGridCells() const
+{
+	TArray<FPolyZone_GridCell> Coords;
+	if( GridCellsX <= 0 || GridCellsY <= 0 )
+	{
+		return Coords;
+	}
+
+	const int32 NumCells = GridData.Num();
+	Coords.Reserve(NumCells);
+	for( int32 Index = 0; Index < NumCells; ++Index )
+	{
+		if( GridData[Index] == POLYZONE_CELL_FLAGS::Outside )
+		{
+			continue;
+		}
+
+		const int32 GridX = Index % GridCellsX;
+		const int32 GridY = Index / GridCellsX;
+		Coords.Add(FPolyZone_GridCell(GridX, GridY));
+	}
+	return Coords;
+}
+
+SIZE_T FPolyZone_Shape::GetAllocatedSize() const
+{
+	SIZE_T Size = sizeof(FPolyZone_Shape);
+	Size += Polygon.GetAllocatedSize();
+	Size += EdgeDistances.GetAllocatedSize();
+	Size += ConvexPolygon.GetAllocatedSize();
+	Size += ConvexPieces.GetAllocatedSize();
+	for( const FPolyZone_ConvexPiece& Piece : ConvexPieces )
+	{
+		Size += Piece.Points.GetAllocatedSize();
+	}
+	Size += GridData.GetAllocatedSize();
+	Size += CellComponents.GetAllocatedSize();
+	Size += FixedPolygon.GetAllocatedSize();
+	return Size;
+}
@@ -0,0 +1,47 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+// "stat PolyZones" in game, counters reset every frame and add up across all zones
+DECLARE_STATS_GROUP(TEXT("PolyZones"), STATGROUP_PolyZones, STATCAT_Advanced);
+
+// -- Build --
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build"), STAT_PolyZone_Build, STATGROUP_PolyZones, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Polygon"), STAT_PolyZone_BuildPolygon, STATGROUP_PolyZones, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Shape"), STAT_PolyZone_BuildShape, STATGROUP_PolyZones, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Query Path"), STAT_PolyZone_BuildQueryPath, STATGROUP_PolyZones, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Grid"), STAT_PolyZone_BuildGrid, STATGROUP_PolyZones, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Bounds"), STAT_PolyZone_BuildBounds, STATGROUP_PolyZones, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Build Visualizer"), STAT_PolyZone_BuildVisualizer, STATGROUP_PolyZones, );
+
+// -- Runtime --
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Actor Tracking"), STAT_PolyZone_ActorTracking, STATGROUP_PolyZones, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Point Query"), STAT_PolyZone_PointQuery, STATGROUP_PolyZones, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Event Dispatch"), STAT_PolyZone_EventDispatch, STATGROUP_PolyZones, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Random Points"), STAT_PolyZone_RandomPoints, STATGROUP_PolyZones, );
+
+// -- Counters --
+// Counted once per batch, never per point. The grid and polygon counters only cover batch queries (ArePointsWithinPolyZone and tracking)
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Active Zones"), STAT_PolyZone_ActiveZones, STATGROUP_PolyZones, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Tracked Actors"), STAT_PolyZone_TrackedActors, STATGROUP_PolyZones, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Actors In Zones"), STAT_PolyZone_ActorsInZones, STATGROUP_PolyZones, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Events"), STAT_PolyZone_Events, STATGROUP_PolyZones, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Point Queries"), STAT_PolyZone_PointQueries, STATGROUP_PolyZones, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Grid Within"), STAT_PolyZone_GridWithin, STATGROUP_PolyZones, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Grid Outside"), STAT_PolyZone_GridOutside, STATGROUP_PolyZones, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Grid OnEdge Fallbacks"), STAT_PolyZone_GridOnEdge, STATGROUP_PolyZones, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Polygon Tests"), STAT_PolyZone_PolygonTests, STATGROUP_PolyZones, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Query Cache Hits"), STAT_PolyZone_QueryCacheHits, STATGROUP_PolyZones, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Query Cache Misses"), STAT_PolyZone_QueryCacheMisses, STATGROUP_PolyZones, );
+
+// -- Memory --
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Unique Shapes"), STAT_PolyZone_Shapes, STATGROUP_PolyZones, );
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Shape Memory"), STAT_PolyZone_ShapeMemory, STATGROUP_PolyZones, );
+
+// "csvprofile start", also available on dedicated servers and test builds
+CSV_DECLARE_CATEGORY_EXTERN(PolyZones);
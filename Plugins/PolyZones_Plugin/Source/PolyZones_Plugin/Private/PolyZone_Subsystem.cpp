@@ -0,0 +1,722 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_Subsystem.h"
+#include "PolyZone.h"
+#include "PolyZones_Plugin.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarPolyZoneBuildBudgetMs(
+	TEXT("PolyZones.BuildBudgetMs"),
+	2.0f,
+	TEXT("Milliseconds a frame spent building PolyZones that were streamed in while playing, at least one zone is built every frame. 0 builds them in BeginPlay."));
+
+UPolyZone_Subsystem* UPolyZone_Subsystem::Get(const UObject* WorldContextObject)
+{
+	const UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::ReturnNull) : nullptr;
+	return World ? World->GetSubsystem<UPolyZone_Subsystem>() : nullptr;
+}
+
+void UPolyZone_Subsystem::Deinitialize()
+{
+	Zones.Empty();
+	FreeSlots.Empty();
+	ZoneSlots.Empty();
+	BoundsGrid.Empty();
+	OversizedSlots.Empty();
+	ActorZoneSlots.Empty();
+	ListedNeighbours.Empty();
+	MaxNeighbourDistance = 0.0f;
+	TreeNodes.Empty();
+	bTreeDirty = true;
+	BuildQueue.Empty();
+	BuildQueueHead = 0;
+	Super::Deinitialize();
+}
+
+TStatId UPolyZone_Subsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UPolyZone_Subsystem, STATGROUP_Tickables);
+}
+
+void UPolyZone_Subsystem::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+	if( BuildQueueHead >= BuildQueue.Num() )
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPolyZone_Subsystem::BuildQueue);
+	const double EndTime = FPlatformTime::Seconds() + CVarPolyZoneBuildBudgetMs.GetValueOnGameThread() * 0.001;
+	do // At least one zone a frame, so the queue always drains
+	{
+		APolyZone* Zone = BuildQueue[BuildQueueHead++].Get();
+		if( IsValid(Zone) && Zone->bBuildQueued ) // Zones that ended play before their turn clear the flag
+		{
+			Zone->Activate_PolyZone();
+		}
+	}
+	while( BuildQueueHead < BuildQueue.Num() && FPlatformTime::Seconds() < EndTime );
+
+	if( BuildQueueHead >= BuildQueue.Num() )
+	{
+		BuildQueue.Reset();
+		BuildQueueHead = 0;
+	}
+}
+
+bool UPolyZone_Subsystem::ShouldDeferBuild(const APolyZone* Zone) const
+{
+	const UWorld* World = GetWorld();
+	return CVarPolyZoneBuildBudgetMs.GetValueOnGameThread() > 0.0f && World && World->HasBegunPlay() && Zone->GetLevel() && !Zone->GetLevel()->IsPersistentLevel();
+}
+
+void UPolyZone_Subsystem::QueueBuild(APolyZone* Zone)
+{
+	Zone->bBuildQueued = true;
+	BuildQueue.Add(Zone);
+}
+
+// ==================== REGISTRATION ====================
+
+void UPolyZone_Subsystem::RegisterZone(APolyZone* Zone)
+{
+	if( !IsValid(Zone) || !Zone->GetShape().IsValid() || ZoneSlots.Contains(Zone) )
+	{
+		return;
+	}
+
+	const int32 Slot = FreeSlots.Num() > 0 ? FreeSlots.Pop(false) : Zones.AddDefaulted();
+	FZoneEntry& Entry = Zones[Slot];
+	Entry.Zone = Zone;
+	Entry.Neighbours.Reset();
+	Entry.Members.Reset();
+	ZoneSlots.Add(Zone, Slot);
+	MaxNeighbourDistance = FMath::Max(MaxNeighbourDistance, Zone->NeighbourDistance);
+	for( const APolyZone* Listed : Zone->NeighbourZones )
+	{
+		if( Listed )
+		{
+			ListedNeighbours.Add(Listed, Slot);
+		}
+	}
+
+	// World polygon and bounds, the neighbour tests of every zone that registers later use these
+	const FPolyZone_Frame& Frame = Zone->GetZoneFrame();
+	Entry.WorldPolygon.Reset(Zone->GetShape()->Polygon.Num());
+	Entry.Bounds = FBox2D(ForceInit);
+	for( const FVector2D& LocalPoint : Zone->GetShape()->Polygon )
+	{
+		const FVector WorldPoint = Frame.ToWorld(LocalPoint, Frame.Origin.Z);
+		Entry.WorldPolygon.Add(FVector2D(WorldPoint.X, WorldPoint.Y));
+		Entry.Bounds += Entry.WorldPolygon.Last();
+	}
+
+	AddToBoundsGrid(Slot);
+	ComputeNeighbours(Slot);
+	bTreeDirty = true;
+}
+
+void UPolyZone_Subsystem::UnregisterZone(APolyZone* Zone)
+{
+	int32 Slot = INDEX_NONE;
+	if( !ZoneSlots.RemoveAndCopyValue(Zone, Slot) )
+	{
+		return;
+	}
+
+	RemoveFromBoundsGrid(Slot);
+	for( const APolyZone* Listed : Zone->NeighbourZones )
+	{
+		if( Listed )
+		{
+			ListedNeighbours.RemoveSingle(Listed, Slot);
+		}
+	}
+
+	// Neighbours are always set both ways, so only our own neighbours need clearing
+	for( TConstSetBitIterator<> It(Zones[Slot].Neighbours); It; ++It )
+	{
+		TBitArray<>& OtherNeighbours = Zones[It.GetIndex()].Neighbours;
+		if( Slot < OtherNeighbours.Num() )
+		{
+			OtherNeighbours[Slot] = false;
+		}
+	}
+
+	// The zone sends its exits before unregistering, this only catches actors it never got to exit
+	for( const TObjectKey<AActor>& Member : Zones[Slot].Members )
+	{
+		if( TArray<int32, TInlineAllocator<4>>* ActorSlots = ActorZoneSlots.Find(Member) )
+		{
+			ActorSlots->RemoveSingleSwap(Slot, false);
+			if( ActorSlots->Num() == 0 )
+			{
+				ActorZoneSlots.Remove(Member);
+			}
+		}
+	}
+
+	Zones[Slot] = FZoneEntry();
+	FreeSlots.Add(Slot);
+	bTreeDirty = true;
+}
+
+void UPolyZone_Subsystem::RefreshZone(APolyZone* Zone)
+{
+	if( !ZoneSlots.Contains(Zone) )
+	{
+		return;
+	}
+
+	// Keep the memberships, they belong to the slot and RegisterZone hands the freed slot straight back
+	const TArray<TObjectKey<AActor>> Members = Zones[ZoneSlots.FindChecked(Zone)].Members;
+
+	UnregisterZone(Zone);
+	RegisterZone(Zone);
+
+	if( const int32* NewSlot = ZoneSlots.Find(Zone) )
+	{
+		Zones[*NewSlot].Members = Members;
+		for( const TObjectKey<AActor>& Member : Members )
+		{
+			ActorZoneSlots.FindOrAdd(Member).AddUnique(*NewSlot);
+		}
+	}
+}
+
+void UPolyZone_Subsystem::AddToBoundsGrid(int32 Slot)
+{
+	const FBox2D& Bounds = Zones[Slot].Bounds;
+	const FIntPoint MinBucket(FMath::FloorToInt32(Bounds.Min.X / BoundsGridSize), FMath::FloorToInt32(Bounds.Min.Y / BoundsGridSize));
+	const FIntPoint MaxBucket(FMath::FloorToInt32(Bounds.Max.X / BoundsGridSize), FMath::FloorToInt32(Bounds.Max.Y / BoundsGridSize));
+
+	if( int64(MaxBucket.X - MinBucket.X + 1) * int64(MaxBucket.Y - MinBucket.Y + 1) > MaxBucketsPerZone )
+	{
+		OversizedSlots.Add(Slot);
+		return;
+	}
+
+	for( int32 BucketX = MinBucket.X; BucketX <= MaxBucket.X; ++BucketX )
+	{
+		for( int32 BucketY = MinBucket.Y; BucketY <= MaxBucket.Y; ++BucketY )
+		{
+			BoundsGrid.Add(FIntPoint(BucketX, BucketY), Slot);
+		}
+	}
+}
+
+void UPolyZone_Subsystem::RemoveFromBoundsGrid(int32 Slot)
+{
+	if( OversizedSlots.RemoveSingleSwap(Slot, false) > 0 )
+	{
+		return;
+	}
+
+	const FBox2D& Bounds = Zones[Slot].Bounds;
+	const FIntPoint MinBucket(FMath::FloorToInt32(Bounds.Min.X / BoundsGridSize), FMath::FloorToInt32(Bounds.Min.Y / BoundsGridSize));
+	const FIntPoint MaxBucket(FMath::FloorToInt32(Bounds.Max.X / BoundsGridSize), FMath::FloorToInt32(Bounds.Max.Y / BoundsGridSize));
+	for( int32 BucketX = MinBucket.X; BucketX <= MaxBucket.X; ++BucketX )
+	{
+		for( int32 BucketY = MinBucket.Y; BucketY <= MaxBucket.Y; ++BucketY )
+		{
+			BoundsGrid.RemoveSingle(FIntPoint(BucketX, BucketY), Slot);
+		}
+	}
+}
+
+// Zones are neighbours when either one lists the other, or their polygons overlap or come within the larger NeighbourDistance of the two
+void UPolyZone_Subsystem::ComputeNeighbours(int32 Slot)
+{
+	FZoneEntry& Entry = Zones[Slot];
+	APolyZone* Zone = Entry.Zone.Get();
+
+	auto SetNeighbours = [this](int32 SlotA, int32 SlotB)
+	{
+		const int32 NeededBits = FMath::Max(SlotA, SlotB) + 1;
+		for( TBitArray<>* Bits : { &Zones[SlotA].Neighbours, &Zones[SlotB].Neighbours } )
+		{
+			if( Bits->Num() < NeededBits )
+			{
+				Bits->Add(false, NeededBits - Bits->Num());
+			}
+		}
+		Zones[SlotA].Neighbours[SlotB] = true;
+		Zones[SlotB].Neighbours[SlotA] = true;
+	};
+
+	// Listed neighbours, either way round
+	for( const APolyZone* Listed : Zone->NeighbourZones )
+	{
+		const int32* ListedSlot = Listed ? ZoneSlots.Find(Listed) : nullptr;
+		if( ListedSlot && *ListedSlot != Slot )
+		{
+			SetNeighbours(Slot, *ListedSlot);
+		}
+	}
+	TArray<int32, TInlineAllocator<8>> ListingSlots;
+	ListedNeighbours.MultiFind(Zone, ListingSlots);
+	for( const int32 ListingSlot : ListingSlots )
+	{
+		if( ListingSlot != Slot )
+		{
+			SetNeighbours(Slot, ListingSlot);
+		}
+	}
+
+	// Only zones in the bounds grid buckets within reach can be close enough, the full sweep is for zones that reach too far for the buckets
+	TArray<int32, TInlineAllocator<32>> CandidateSlots;
+	const FBox2D SearchBounds = Entry.Bounds.ExpandBy(FMath::Max(Zone->NeighbourDistance, MaxNeighbourDistance));
+	const FIntPoint MinBucket(FMath::FloorToInt32(SearchBounds.Min.X / BoundsGridSize), FMath::FloorToInt32(SearchBounds.Min.Y / BoundsGridSize));
+	const FIntPoint MaxBucket(FMath::FloorToInt32(SearchBounds.Max.X / BoundsGridSize), FMath::FloorToInt32(SearchBounds.Max.Y / BoundsGridSize));
+	if( int64(MaxBucket.X - MinBucket.X + 1) * int64(MaxBucket.Y - MinBucket.Y + 1) > MaxBucketsPerZone )
+	{
+		for( int32 OtherSlot = 0; OtherSlot < Zones.Num(); ++OtherSlot )
+		{
+			CandidateSlots.Add(OtherSlot);
+		}
+	}
+	else
+	{
+		for( int32 BucketX = MinBucket.X; BucketX <= MaxBucket.X; ++BucketX )
+		{
+			for( int32 BucketY = MinBucket.Y; BucketY <= MaxBucket.Y; ++BucketY )
+			{
+				for( auto It = BoundsGrid.CreateConstKeyIterator(FIntPoint(BucketX, BucketY)); It; ++It )
+				{
+					CandidateSlots.Add(It.Value());
+				}
+			}
+		}
+		CandidateSlots.Append(OversizedSlots);
+		Algo::Sort(CandidateSlots);
+		CandidateSlots.SetNum(Algo::Unique(CandidateSlots), false); // Zones span several buckets
+	}
+
+	for( const int32 OtherSlot : CandidateSlots )
+	{
+		const FZoneEntry& Other = Zones[OtherSlot];
+		APolyZone* OtherZone = Other.Zone.Get();
+		if( OtherSlot == Slot || !IsValid(OtherZone) )
+		{
+			continue;
+		}
+
+		if( OtherSlot < Entry.Neighbours.Num() && Entry.Neighbours[OtherSlot] )
+		{
+			continue; // Already listed
+		}
+
+		// Cheap bounds reject first, most zones in a level are nowhere near each other
+		const double Distance = FMath::Max(Zone->NeighbourDistance, OtherZone->NeighbourDistance);
+		if( !Entry.Bounds.ExpandBy(Distance).Intersect(Other.Bounds) )
+		{
+			continue;
+		}
+
+		// One polygon fully inside the other has no edges close to each other, so test a vertex of each against the other zone
+		bool AreNeighbours = OtherZone->IsPointWithinPolyZone(FVector(Entry.WorldPolygon[0], 0.0), true) ||
+			Zone->IsPointWithinPolyZone(FVector(Other.WorldPolygon[0], 0.0), true);
+
+		// Closest pair of edges, also catches crossing edges (distance 0)
+		const double MaxDistanceSquared = FMath::Square(Distance + KINDA_SMALL_NUMBER);
+		for( int32 i = 0; i < Entry.WorldPolygon.Num() && !AreNeighbours; ++i )
+		{
+			const FVector A1(Entry.WorldPolygon[i], 0.0);
+			const FVector A2(Entry.WorldPolygon[(i + 1) % Entry.WorldPolygon.Num()], 0.0);
+			for( int32 j = 0; j < Other.WorldPolygon.Num(); ++j )
+			{
+				const FVector B1(Other.WorldPolygon[j], 0.0);
+				const FVector B2(Other.WorldPolygon[(j + 1) % Other.WorldPolygon.Num()], 0.0);
+				FVector ClosestA, ClosestB;
+				FMath::SegmentDistToSegmentSafe(A1, A2, B1, B2, ClosestA, ClosestB);
+				if( FVector::DistSquared(ClosestA, ClosestB) <= MaxDistanceSquared )
+				{
+					AreNeighbours = true;
+					break;
+				}
+			}
+		}
+
+		if( AreNeighbours )
+		{
+			SetNeighbours(Slot, OtherSlot);
+		}
+	}
+}
+
+// ==================== MEMBERSHIP ====================
+
+void UPolyZone_Subsystem::OnMembershipChange(AActor* Actor, APolyZone* Zone, bool NewIsOverlapped)
+{
+	const int32* Slot = ZoneSlots.Find(Zone);
+	if( !Slot )
+	{
+		return; // Zone isn't playing (yet)
+	}
+
+	if( NewIsOverlapped )
+	{
+		ActorZoneSlots.FindOrAdd(Actor).AddUnique(*Slot);
+		Zones[*Slot].Members.AddUnique(Actor);
+	}
+	else if( TArray<int32, TInlineAllocator<4>>* ActorSlots = ActorZoneSlots.Find(Actor) )
+	{
+		Zones[*Slot].Members.RemoveSingleSwap(Actor, false);
+		ActorSlots->RemoveSingleSwap(*Slot, false);
+		if( ActorSlots->Num() == 0 )
+		{
+			ActorZoneSlots.Remove(Actor);
+		}
+	}
+}
+
+// ==================== QUERIES ====================
+
+TArray<APolyZone*> UPolyZone_Subsystem::GetAllZones() const
+{
+	TArray<APolyZone*> AllZones;
+	AllZones.Reserve(ZoneSlots.Num());
+	for( const FZoneEntry& Entry : Zones )
+	{
+		if( APolyZone* Zone = Entry.Zone.Get() )
+		{
+			AllZones.Add(Zone);
+		}
+	}
+	return AllZones;
+}
+
+TArray<APolyZone*> UPolyZone_Subsystem::GetZonesAtLocation(FVector Location, bool SkipHeight) const
+{
+	TArray<int32, TInlineAllocator<16>> CandidateSlots;
+	BoundsGrid.MultiFind(FIntPoint(FMath::FloorToInt32(Location.X / BoundsGridSize), FMath::FloorToInt32(Location.Y / BoundsGridSize)), CandidateSlots);
+	CandidateSlots.Append(OversizedSlots);
+
+	TArray<APolyZone*> FoundZones;
+	for( const int32 Slot : CandidateSlots )
+	{
+		APolyZone* Zone = Zones[Slot].Zone.Get();
+		if( IsValid(Zone) && Zones[Slot].Bounds.IsInside(FVector2D(Location.X, Location.Y)) && Zone->IsPointWithinPolyZone(Location, SkipHeight) )
+		{
+			FoundZones.Add(Zone);
+		}
+	}
+	return FoundZones;
+}
+
+TArray<APolyZone*> UPolyZone_Subsystem::GetNeighbourZones(APolyZone* Zone) const
+{
+	TArray<APolyZone*> Neighbours;
+	if( const int32* Slot = ZoneSlots.Find(Zone) )
+	{
+		for( TConstSetBitIterator<> It(Zones[*Slot].Neighbours); It; ++It )
+		{
+			if( APolyZone* Neighbour = Zones[It.GetIndex()].Zone.Get() )
+			{
+				Neighbours.Add(Neighbour);
+			}
+		}
+	}
+	return Neighbours;
+}
+
+bool UPolyZone_Subsystem::AreZonesNeighbours(APolyZone* ZoneA, APolyZone* ZoneB) const
+{
+	const int32* SlotA = ZoneSlots.Find(ZoneA);
+	const int32* SlotB = ZoneSlots.Find(ZoneB);
+	if( !SlotA || !SlotB )
+	{
+		return false;
+	}
+	const TBitArray<>& Neighbours = Zones[*SlotA].Neighbours;
+	return *SlotB < Neighbours.Num() && Neighbours[*SlotB];
+}
+
+TArray<APolyZone*> UPolyZone_Subsystem::GetZonesOfActor(AActor* Actor) const
+{
+	TArray<APolyZone*> ActorZones;
+	if( const TArray<int32, TInlineAllocator<4>>* ActorSlots = ActorZoneSlots.Find(Actor) )
+	{
+		for( const int32 Slot : *ActorSlots )
+		{
+			if( APolyZone* Zone = Zones[Slot].Zone.Get() )
+			{
+				ActorZones.Add(Zone);
+			}
+		}
+	}
+	return ActorZones;
+}
+
+bool UPolyZone_Subsystem::AreSlotsRelated(TConstArrayView<int32> SlotsA, TConstArrayView<int32> SlotsB, bool IncludeNeighbours) const
+{
+	for( const int32 SlotA : SlotsA )
+	{
+		const TBitArray<>& Neighbours = Zones[SlotA].Neighbours;
+		for( const int32 SlotB : SlotsB )
+		{
+			if( SlotA == SlotB || (IncludeNeighbours && SlotB < Neighbours.Num() && Neighbours[SlotB]) )
+			{
+				return true;
+			}
+		}
+	}
+	return false;
+}
+
+bool UPolyZone_Subsystem::AreActorsInRelatedZones(AActor* ActorA, AActor* ActorB, bool IncludeNeighbours) const
+{
+	const TArray<int32, TInlineAllocator<4>>* SlotsA = ActorZoneSlots.Find(ActorA);
+	const TArray<int32, TInlineAllocator<4>>* SlotsB = ActorZoneSlots.Find(ActorB);
+	return SlotsA && SlotsB && AreSlotsRelated(*SlotsA, *SlotsB, IncludeNeighbours);
+}
+
+TOptional<bool> UPolyZone_Subsystem::IsNetRelevantByZone(const AActor* Actor, const AActor* RealViewer, const AActor* ViewTarget) const
+{
+	// The engine's own answers come first, an actor stays relevant to its owner, instigator and view target wherever the zones are
+	if( !Actor || Actor->bAlwaysRelevant || Actor->bOnlyRelevantToOwner || Actor->bNetUseOwnerRelevancy
+		|| Actor == ViewTarget || Actor->IsOwnedBy(ViewTarget) || Actor->IsOwnedBy(RealViewer) || (ViewTarget && ViewTarget == Actor->GetInstigator()) )
+	{
+		return {};
+	}
+
+	const TArray<int32, TInlineAllocator<4>>* ActorSlots = ActorZoneSlots.Find(Actor);
+	if( !ActorSlots )
+	{
+		return {};
+	}
+
+	const TArray<int32, TInlineAllocator<4>>* ViewerSlots = ActorZoneSlots.Find(ViewTarget);
+	if( !ViewerSlots )
+	{
+		ViewerSlots = ActorZoneSlots.Find(RealViewer);
+	}
+	if( !ViewerSlots )
+	{
+		return {};
+	}
+
+	if( AreSlotsRelated(*ActorSlots, *ViewerSlots, true) )
+	{
+		return {}; // Zones only ever narrow relevancy, related actors still go through the distance rules
+	}
+	return false;
+}
+
+// ==================== NEAREST ZONES ====================
+
+void UPolyZone_Subsystem::BuildTree()
+{
+	TreeNodes.Reset();
+	bTreeDirty = false;
+
+	TArray<int32> Slots;
+	for( int32 Slot = 0; Slot < Zones.Num(); ++Slot )
+	{
+		if( Zones[Slot].Zone.IsValid() )
+		{
+			Slots.Add(Slot);
+		}
+	}
+	if( Slots.Num() > 0 )
+	{
+		TreeNodes.Reserve(Slots.Num() * 2 - 1);
+		BuildTreeNode(Slots);
+	}
+}
+
+// Splits the zones in half along the longest axis of their centers
+int32 UPolyZone_Subsystem::BuildTreeNode(TArrayView<int32> Slots)
+{
+	const int32 NodeIndex = TreeNodes.AddDefaulted();
+
+	FBox2D Bounds(ForceInit);
+	FBox2D Centers(ForceInit);
+	for( const int32 Slot : Slots )
+	{
+		Bounds += Zones[Slot].Bounds;
+		Centers += Zones[Slot].Bounds.GetCenter();
+	}
+	TreeNodes[NodeIndex].Bounds = Bounds;
+
+	if( Slots.Num() == 1 )
+	{
+		TreeNodes[NodeIndex].Slot = Slots[0];
+		return NodeIndex;
+	}
+
+	const int32 Axis = Centers.GetSize().X >= Centers.GetSize().Y ? 0 : 1;
+	Algo::Sort(Slots, [this, Axis](int32 SlotA, int32 SlotB) { return Zones[SlotA].Bounds.GetCenter()[Axis] < Zones[SlotB].Bounds.GetCenter()[Axis]; });
+
+	// Children are added after this node, so only hold indices across the recursion
+	const int32 Middle = Slots.Num() / 2;
+	const int32 LeftChild = BuildTreeNode(Slots.Slice(0, Middle));
+	const int32 RightChild = BuildTreeNode(Slots.Slice(Middle, Slots.Num() - Middle));
+	TreeNodes[NodeIndex].Children[0] = LeftChild;
+	TreeNodes[NodeIndex].Children[1] = RightChild;
+	return NodeIndex;
+}
+
+// Exact distance to the zone polygon, 0 inside it
+double UPolyZone_Subsystem::GetZoneDistance(int32 Slot, const FVector2D& Point, FVector2D& OutClosest) const
+{
+	const FZoneEntry& Entry = Zones[Slot];
+	APolyZone* Zone = Entry.Zone.Get();
+	if( Entry.Bounds.IsInside(Point) && IsValid(Zone) && Zone->IsPointWithinPolyZone(FVector(Point, 0.0), true) )
+	{
+		OutClosest = Point;
+		return 0.0;
+	}
+
+	double BestDistanceSquared = TNumericLimits<double>::Max();
+	const int32 NumPoints = Entry.WorldPolygon.Num();
+	for( int32 i = 0, j = NumPoints - 1; i < NumPoints; j = i++ )
+	{
+		const FVector2D Closest = FMath::ClosestPointOnSegment2D(Point, Entry.WorldPolygon[j], Entry.WorldPolygon[i]);
+		const double DistanceSquared = FVector2D::DistSquared(Point, Closest);
+		if( DistanceSquared < BestDistanceSquared )
+		{
+			BestDistanceSquared = DistanceSquared;
+			OutClosest = Closest;
+		}
+	}
+	return FMath::Sqrt(BestDistanceSquared);
+}
+
+// Best first walk of the tree, a node is only opened if its box could hold something closer than the Count best zones found so far
+void UPolyZone_Subsystem::FindNearestSlots(const FVector2D& Point, int32 Count, double MaxDistance, int32 HintSlot)
+{
+	if( bTreeDirty )
+	{
+		BuildTree();
+	}
+
+	SearchBest.Reset();
+	SearchNodes.Reset();
+	if( TreeNodes.Num() == 0 || Count <= 0 )
+	{
+		return;
+	}
+
+	auto IsCloser = [](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key < B.Key; };
+	auto IsFurther = [](const TPair<double, int32>& A, const TPair<double, int32>& B) { return A.Key > B.Key; };
+
+	double Limit = MaxDistance > 0.0 ? MaxDistance : TNumericLimits<double>::Max();
+	auto Consider = [&](int32 Slot)
+	{
+		FVector2D Closest;
+		const double Distance = GetZoneDistance(Slot, Point, Closest);
+		if( Distance > Limit )
+		{
+			return;
+		}
+		SearchBest.HeapPush(TPair<double, int32>(Distance, Slot), IsFurther);
+		if( SearchBest.Num() > Count )
+		{
+			SearchBest.HeapPopDiscard(IsFurther);
+		}
+		if( SearchBest.Num() == Count )
+		{
+			Limit = FMath::Min(Limit, SearchBest.HeapTop().Key);
+		}
+	};
+
+	// A good first answer prunes most of the tree straight away
+	const bool UseHint = Zones.IsValidIndex(HintSlot) && Zones[HintSlot].Zone.IsValid();
+	if( UseHint )
+	{
+		Consider(HintSlot);
+	}
+
+	SearchNodes.HeapPush(TPair<double, int32>(TreeNodes[0].Bounds.ComputeSquaredDistanceToPoint(Point), 0), IsCloser);
+	while( SearchNodes.Num() > 0 )
+	{
+		TPair<double, int32> Next;
+		SearchNodes.HeapPop(Next, IsCloser, false);
+		if( Next.Key > FMath::Square(Limit) )
+		{
+			break; // Every node left is further away
+		}
+
+		const FTreeNode& Node = TreeNodes[Next.Value];
+		if( Node.Slot != INDEX_NONE )
+		{
+			if( !UseHint || Node.Slot != HintSlot )
+			{
+				Consider(Node.Slot);
+			}
+			continue;
+		}
+
+		for( const int32 Child : Node.Children )
+		{
+			const double BoxDistanceSquared = TreeNodes[Child].Bounds.ComputeSquaredDistanceToPoint(Point);
+			if( BoxDistanceSquared <= FMath::Square(Limit) )
+			{
+				SearchNodes.HeapPush(TPair<double, int32>(BoxDistanceSquared, Child), IsCloser);
+			}
+		}
+	}
+
+	SearchBest.Sort(IsCloser);
+}
+
+FPolyZone_ZoneDistance UPolyZone_Subsystem::MakeZoneDistance(int32 Slot, const FVector2D& Point) const
+{
+	FVector2D Closest;
+	FPolyZone_ZoneDistance Result;
+	Result.Zone = Zones[Slot].Zone.Get();
+	Result.Distance = GetZoneDistance(Slot, Point, Closest);
+	Result.ClosestPoint = FVector(Closest, Result.Zone ? Result.Zone->GetZoneFrame().Origin.Z : 0.0);
+	return Result;
+}
+
+bool UPolyZone_Subsystem::FindNearestZone(FVector Location, FPolyZone_ZoneDistance& Nearest, float MaxDistance)
+{
+	const FVector2D Point(Location.X, Location.Y);
+	FindNearestSlots(Point, 1, MaxDistance, INDEX_NONE);
+	if( SearchBest.Num() == 0 )
+	{
+		return false;
+	}
+	Nearest = MakeZoneDistance(SearchBest[0].Value, Point);
+	return true;
+}
+
+TArray<FPolyZone_ZoneDistance> UPolyZone_Subsystem::FindNearestZones(FVector Location, int32 Count, float MaxDistance)
+{
+	const FVector2D Point(Location.X, Location.Y);
+	FindNearestSlots(Point, Count, MaxDistance, INDEX_NONE);
+
+	TArray<FPolyZone_ZoneDistance> NearestZones;
+	NearestZones.Reserve(SearchBest.Num());
+	for( const TPair<double, int32>& Best : SearchBest )
+	{
+		NearestZones.Add(MakeZoneDistance(Best.Value, Point));
+	}
+	return NearestZones;
+}
+
+TArray<FPolyZone_ZoneDistance> UPolyZone_Subsystem::FindNearestZoneBatch(const TArray<FVector>& Locations, float MaxDistance)
+{
+	TArray<FPolyZone_ZoneDistance> NearestZones;
+	NearestZones.SetNum(Locations.Num());
+
+	int32 HintSlot = INDEX_NONE;
+	for( int32 i = 0; i < Locations.Num(); ++i )
+	{
+		const FVector2D Point(Locations[i].X, Locations[i].Y);
+		FindNearestSlots(Point, 1, MaxDistance, HintSlot);
+		if( SearchBest.Num() > 0 )
+		{
+			HintSlot = SearchBest[0].Value;
+			NearestZones[i] = MakeZoneDistance(HintSlot, Point);
+		}
+	}
+	return NearestZones;
+}
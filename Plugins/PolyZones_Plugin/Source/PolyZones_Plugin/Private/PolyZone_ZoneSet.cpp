@@ -0,0 +1,147 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#include "PolyZone_ZoneSet.h"
+#include "PolyZone.h"
+#include "PolyZone_Importer.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+
+void UPolyZone_ZoneSet::PostLoad()
+{
+	Super::PostLoad();
+	ResetCaches();
+}
+
+#if WITH_EDITOR
+void UPolyZone_ZoneSet::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	for( FPolyZone_ZoneSetEntry& Entry : Zones )
+	{
+		Entry.Bounds = FBox2D(ForceInit);
+		for( const FVector2D& Point : Entry.Polygon )
+		{
+			Entry.Bounds += Point + FVector2D(Entry.Origin.X, Entry.Origin.Y); // Bounds are only written on import
+		}
+	}
+	ResetCaches(); // A shape is only built when its slot is empty, an edited polygon would keep the old one
+}
+#endif
+
+void UPolyZone_ZoneSet::ResetCaches()
+{
+	Shapes.Reset();
+	BoundsGrid.Reset();
+	OversizedZones.Reset();
+	bBoundsGridBuilt = false;
+}
+
+void UPolyZone_ZoneSet::BuildShapes()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPolyZone_ZoneSet::BuildShapes);
+	Shapes.SetNum(Zones.Num());
+
+	const FPolyZone_ShapeSettings Settings; // Same as a default zone actor, so spawned zones share these shapes
+	ParallelFor(Zones.Num(), [this, &Settings](int32 Index)
+	{
+		if( Shapes[Index].IsValid() || Zones[Index].Polygon.Num() < 3 )
+		{
+			return;
+		}
+
+		const FPolyZone_ZoneSetEntry& Entry = Zones[Index];
+		Shapes[Index] = FPolyZone_Shape::FindOrBuild(Entry.Polygon, Settings, nullptr, Entry.BakedGrid.Find(FPolyZone_Shape::GetSourceHash(Entry.Polygon, Settings), Entry.Polygon));
+	});
+}
+
+void UPolyZone_ZoneSet::BuildBoundsGrid()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UPolyZone_ZoneSet::BuildBoundsGrid);
+	BoundsGrid.Reset();
+	OversizedZones.Reset();
+	for( int32 Index = 0; Index < Zones.Num(); ++Index )
+	{
+		const FBox2D& Bounds = Zones[Index].Bounds;
+		if( !Bounds.bIsValid )
+		{
+			continue;
+		}
+
+		const FIntPoint MinBucket(FMath::FloorToInt32(Bounds.Min.X / BoundsGridSize), FMath::FloorToInt32(Bounds.Min.Y / BoundsGridSize));
+		const FIntPoint MaxBucket(FMath::FloorToInt32(Bounds.Max.X / BoundsGridSize), FMath::FloorToInt32(Bounds.Max.Y / BoundsGridSize));
+		const int64 NumBuckets = int64(MaxBucket.X - MinBucket.X + 1) * int64(MaxBucket.Y - MinBucket.Y + 1);
+		if( NumBuckets > MaxBucketsPerZone )
+		{
+			OversizedZones.Add(Index);
+			continue;
+		}
+
+		for( int32 BucketY = MinBucket.Y; BucketY <= MaxBucket.Y; ++BucketY )
+		{
+			for( int32 BucketX = MinBucket.X; BucketX <= MaxBucket.X; ++BucketX )
+			{
+				BoundsGrid.Add(FIntPoint(BucketX, BucketY), Index);
+			}
+		}
+	}
+	bBoundsGridBuilt = true;
+}
+
+TArray<int32> UPolyZone_ZoneSet::GetZonesAtLocation(FVector Location, bool SkipHeight)
+{
+	if( Shapes.Num() != Zones.Num() )
+	{
+		BuildShapes();
+	}
+	if( !bBoundsGridBuilt )
+	{
+		BuildBoundsGrid();
+	}
+
+	TArray<int32> CandidateZones;
+	BoundsGrid.MultiFind(FIntPoint(FMath::FloorToInt32(Location.X / BoundsGridSize), FMath::FloorToInt32(Location.Y / BoundsGridSize)), CandidateZones);
+	CandidateZones.Append(OversizedZones);
+
+	TArray<int32> FoundZones;
+	const FVector2D Point(Location.X, Location.Y);
+	for( const int32 Index : CandidateZones )
+	{
+		const FPolyZone_ZoneSetEntry& Entry = Zones[Index];
+		if( !Entry.Bounds.IsInside(Point) || !Shapes[Index].IsValid() )
+		{
+			continue;
+		}
+		if( !SkipHeight && !FMath::IsWithinInclusive<double>(Location.Z, Entry.Origin.Z, Entry.Origin.Z + Entry.Height) )
+		{
+			continue;
+		}
+		if( Shapes[Index]->IsPointWithinShape(Point - FVector2D(Entry.Origin.X, Entry.Origin.Y)) )
+		{
+			FoundZones.Add(Index);
+		}
+	}
+	FoundZones.Sort(); // Oversized zones were appended out of order
+	return FoundZones;
+}
+
+TArray<APolyZone*> UPolyZone_ZoneSet::SpawnZones(const UObject* WorldContextObject, TSubclassOf<APolyZone> ZoneClass)
+{
+	TArray<APolyZone*> SpawnedZones;
+	UWorld* World = GEngine ? GEngine->GetWorldFromContextObject(WorldContextObject, EGetWorldErrorMode::LogAndReturnNull) : nullptr;
+	if( !World )
+	{
+		return SpawnedZones;
+	}
+
+	BuildShapes(); // Warms the shape cache, every spawn below is then a cache hit
+	SpawnedZones.Reserve(Zones.Num());
+	for( const FPolyZone_ZoneSetEntry& Entry : Zones )
+	{
+		if( APolyZone* Zone = FPolyZone_Importer::SpawnZone(World, ZoneClass, Entry.Name, Entry.Origin, Entry.Height, Entry.Polygon) )
+		{
+			SpawnedZones.Add(Zone);
+		}
+	}
+	return SpawnedZones;
+}
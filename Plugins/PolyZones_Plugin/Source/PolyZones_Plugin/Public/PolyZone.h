@@ -4,11 +4,38 @@
 
 #include "CoreMinimal.h"
 #include "PolyZone_Grid.h"
+#include "PolyZone_Geometry.h"
+#include "PolyZone_Shape.h"
+#include "PolyZone_Replication.h"
+#include "PolyZone_Occupancy.h"
+#include "PolyZone_GridSearch.h"
+#include "PolyZone_QuerySnapshot.h"
+#include "PolyZone_HeightField.h"
 #include "Components/SplineComponent.h"
 // ReSharper disable once CppUnusedIncludeDirective
 #include "Components/ShapeComponent.h" // Needed for compiling in Game Mode
 #include "PolyZone.generated.h"
 
+class ULineBatchComponent;
+
+// A point on a zone's outline
+USTRUCT(BlueprintType)
+struct FPolyZone_EdgePoint
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "PolyZone")
+	FVector Location = FVector::ZeroVector;
+
+	// Horizontal, pointing out of the zone
+	UPROPERTY(BlueprintReadOnly, Category = "PolyZone")
+	FVector Normal = FVector::ZeroVector;
+
+	// The edge from vertex EdgeIndex to the next one of the zone's polygon
+	UPROPERTY(BlueprintReadOnly, Category = "PolyZone")
+	int32 EdgeIndex = INDEX_NONE;
+};
+
 UCLASS(HideCategories=(Input), meta=(PrioritizeCategories="PolyZone"))
 class POLYZONES_PLUGIN_API APolyZone : public AActor
 {
@@ -23,6 +50,10 @@ public:
 	virtual void Tick(float DeltaTime) override;
 	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void K2_DestroyActor() override;
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+	#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	#endif
 
 	// ==================== INPUTS & OUTPUTS ====================
 
@@ -41,12 +72,61 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "PolyZone")
 	bool IsPointWithinPolyZone(FVector TestPoint, bool SkipHeight = false);
 
+	/*Batch IsPointWithinPolyZone, cheaper than calling it per point because the grid resolves every point in one pass*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	TArray<bool> ArePointsWithinPolyZone(const TArray<FVector>& TestPoints, bool SkipHeight = false);
+
 	UFUNCTION(BlueprintCallable, Category = "PolyZone")
 	TArray<FVector> GetRandomPointsInPolyZone(int NumPoints, bool RandomHeight);
 
+	/*Blue noise points, no two closer than MinSpacing (cm), gaps are retried cell by cell until only slivers too thin to hit are left. MaxPoints 0 fills the zone
+	 *For foliage, loot and spawns that shouldn't clump*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	TArray<FVector> GetPoissonPointsInPolyZone(float MinSpacing, int MaxPoints, bool RandomHeight);
+
+	/*GetPoissonPointsInPolyZone drawn from a stream, the same seed gives the same points*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	TArray<FVector> GetPoissonPointsInPolyZoneFromStream(UPARAM(ref) FRandomStream& Stream, float MinSpacing, int MaxPoints, bool RandomHeight);
+
+	/*One point per Spacing (cm) grid cell inside the zone, moved up to Jitter (0-1) of a cell. Cheaper than Poisson points, at least Spacing * (1 - Jitter) apart*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	TArray<FVector> GetStratifiedPointsInPolyZone(float Spacing, float Jitter, bool RandomHeight);
+
+	/*GetStratifiedPointsInPolyZone drawn from a stream, the same seed gives the same points*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	TArray<FVector> GetStratifiedPointsInPolyZoneFromStream(UPARAM(ref) FRandomStream& Stream, float Spacing, float Jitter, bool RandomHeight);
+
 	UFUNCTION(BlueprintCallable, Category = "PolyZone")
 	TArray<FVector> GetRandomPointsAlongPolyZoneEdges(int NumPoints, bool RandomHeight);
 
+	/*Random points on the outline, uniform by length, with the outward normal and edge of each*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	TArray<FPolyZone_EdgePoint> GetRandomEdgePoints(int NumPoints, bool RandomHeight);
+
+	/*GetRandomEdgePoints drawn from a stream, the same seed gives the same points*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	TArray<FPolyZone_EdgePoint> GetRandomEdgePointsFromStream(UPARAM(ref) FRandomStream& Stream, int NumPoints, bool RandomHeight);
+
+	/*Points spaced evenly along the outline, starting StartDistance (cm) from the first spline point. For patrol routes and perimeter spawns*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	TArray<FPolyZone_EdgePoint> GetEvenlySpacedEdgePoints(int NumPoints, float StartDistance = 0.0f);
+
+	/*Length of the outline in world units (cm)*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	float GetPerimeterLength() const;
+
+	/*Changes ZoneHeight, query snapshots taken before go stale right away*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	void SetZoneHeight(float NewZoneHeight);
+
+	/*Share of point and actor queries answered by the query cache (0-1), since the last reset*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	float GetQueryCacheHitRate(bool ResetCounts = false);
+
+	/*World Z the zone starts at under a location, the lowest floor of that grid cell (the actor's Z for Flat zones)*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone")
+	float GetFloorAtLocation(FVector Location) const;
+
 	UFUNCTION(BlueprintCallable, Category = "PolyZone", meta=(DeterminesOutputType="Class", DynamicOutputParam="Actors"))
 	void GetAllActorsOfClassWithinPolyZone(TSubclassOf<AActor> Class, TArray<AActor*>& Actors);
 
@@ -68,6 +148,72 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "PolyZone|Grid")
 	POLYZONE_CELL_FLAGS GetFlagAtLocation(FVector Location);
 
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Grid")
+	TArray<POLYZONE_CELL_FLAGS> GetFlagsAtLocations(const TArray<FVector>& Locations);
+
+	/*Flags of every grid cell, indexed X + (Y * GridCellsX)*/
+	UFUNCTION(BlueprintPure, Category = "PolyZone|Grid")
+	TArray<POLYZONE_CELL_FLAGS> GetGridData() const;
+
+	/*Island of connected Within cells the cell belongs to (-1 if the cell isn't Within), cells of the same island can reach each other*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Grid")
+	int32 GetGridCellComponent(const FPolyZone_GridCell& Cell);
+
+	/*Every Within cell (and OnEdge cell with AllowEdgeCells) connected to the start cell, nearest first (0 MaxCells = no limit)*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Grid")
+	TArray<FPolyZone_GridCell> FloodFillGrid(const FPolyZone_GridCell& StartCell, bool AllowEdgeCells = false, int32 MaxCells = 0);
+
+	/*Cells from start to goal (both included) through Within cells, and OnEdge cells with AllowEdgeCells
+	 *Diagonal paths are the shortest A* path, otherwise the path with the fewest steps*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Grid")
+	bool FindGridPath(const FPolyZone_GridCell& StartCell, const FPolyZone_GridCell& GoalCell, TArray<FPolyZone_GridCell>& Path, bool AllowDiagonal = true, bool AllowEdgeCells = false);
+
+	/*Within cell closest to a location inside or outside the zone, for coarse navigation and spawn placement*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Grid")
+	bool FindNearestWithinCell(FVector Location, FPolyZone_GridCell& Cell, bool AllowEdgeCells = false);
+
+	// -- Occupancy (needs bOccupancyLayer and a zone with a grid) --
+
+	/*Tracked actors in the cell right now*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Occupancy")
+	int32 GetCellOccupancy(const FPolyZone_GridCell& Cell) const;
+
+	/*Average number of tracked actors in the cell, recent time counts the most (see OccupancyHalfLife)*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Occupancy")
+	float GetCellOccupancyHistory(const FPolyZone_GridCell& Cell) const;
+
+	/*The most occupied cells first, empty cells are never returned*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Occupancy")
+	TArray<FPolyZone_GridCell> GetDensestCells(int32 MaxCells = 5, bool UseHistory = false) const;
+
+	/*Writes X,Y,Count,History for every cell, an empty path writes to Saved/PolyZoneOccupancy*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Occupancy")
+	bool ExportOccupancyCsv(FString FilePath);
+
+	/*One texel per grid cell (R32 float, raw counts or history), for heatmap materials and debug widgets*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Occupancy")
+	UTexture2D* CreateOccupancyTexture(bool UseHistory = false) const;
+
+	// Local space geometry of this zone, shared with every zone of the same shape
+	FPolyZone_ShapePtr GetShape() const { return Shape; }
+
+	// Maps world locations into the space of GetShape()
+	const FPolyZone_Frame& GetZoneFrame() const { return ZoneFrame; }
+
+	// The shape settings from this zone's config, shapes built elsewhere with these are shared with the zone
+	FPolyZone_ShapeSettings GetShapeSettings() const;
+
+	/*Immutable copy of the query data for worker threads (AI, EQS, physics tasks), game thread only
+	 *The same snapshot is returned until the zone is rebuilt, moved or changes height. Null until the zone has been built*/
+	FPolyZone_QuerySnapshotPtr GetQuerySnapshot();
+
+	// Bumped whenever snapshots go stale
+	uint32 GetQueryVersion() const { return QueryVersion->load(std::memory_order_acquire); }
+
+	/*True on clients of a zone with bReplicateMembership, these zones never track actors themselves*/
+	UFUNCTION(BlueprintPure, Category = "PolyZone")
+	bool IsMembershipFromServer() const;
+
 protected:
 	
 	/*Called at the end of C++ construction*/
@@ -91,6 +237,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config")
 	bool ActorTracking = true;
 
+	/*Remember point and actor query results until the next frame, so systems asking about the same actors in one frame share one test
+	 *Actor tracking fills the cache too, and with ActorTracking off the actor lists are only refreshed once a frame. Only worth it when queries repeat*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config", AdvancedDisplay)
+	bool bCacheQueries = false;
+
 	/*Color associated with this zone, can be useful for showing debug text*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config")
 	FColor ZoneColor = FColor(0, 255, 0, 255);
@@ -104,12 +255,93 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config")
 	TArray<TEnumAsByte<ECollisionChannel>> OverlapTypes;
 
-	/*The height of the PolyZone's overlap bounds
+	/*The height of the PolyZone's overlap bounds, measured from the floor of each grid cell when HeightMode isn't Flat
 	 *If you need an infinite height, you will need to call the WithinPolyZone functions manually with "SkipHeight" enabled*/
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config")
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, BlueprintSetter = SetZoneHeight, Category = "PolyZone Config")
 	float ZoneHeight = 250.0f;
 
-	/*Draw grid cell debug boxes in the world*/
+	/*Where the zone's floor is. SplineHeight keeps the spline points at their own height instead of flattening them to the actor
+	 *The per cell floors are baked on build and need a grid (6 or more vertices), the overlap box is fitted to them*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone Config")
+	POLYZONE_HEIGHT_MODE HeightMode = POLYZONE_HEIGHT_MODE::Flat;
+
+	/*Trace channel used to find the terrain below each cell*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone Config", AdvancedDisplay, meta=(EditCondition="HeightMode == POLYZONE_HEIGHT_MODE::TerrainTrace"))
+	TEnumAsByte<ECollisionChannel> HeightTraceChannel = ECollisionChannel::ECC_WorldStatic;
+
+	/*How far above and below the actor the terrain is searched for (cm), cells with nothing in range keep the actor's height*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone Config", AdvancedDisplay, meta=(EditCondition="HeightMode == POLYZONE_HEIGHT_MODE::TerrainTrace", ClampMin="1"))
+	float HeightTraceDistance = 5000.0f;
+
+	/*Server authoritative actor tracking, only the server tracks actors and clients receive the enters and exits through replication
+	 *Tracked actors must replicate to be seen on clients. The zone replicates and is always relevant while this is enabled*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone Config")
+	bool bReplicateMembership = false;
+
+	/*Zones whose polygons come closer than this (cm) are neighbours in the PolyZone subsystem, used for zone relevancy*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone Config", AdvancedDisplay, meta=(ClampMin="0"))
+	float NeighbourDistance = 0.0f;
+
+	/*Zones that are always neighbours of this one, however far apart they are (for example zones joined by a door or teleporter)*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone Config", AdvancedDisplay)
+	TArray<APolyZone*> NeighbourZones;
+
+	/*Allow the zone to move, rotate and scale uniformly at runtime (vehicles, moving platforms, shrinking circles)
+	 *The zone geometry is stored in local space, so moving only updates the zone transform and never rebuilds it*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone Config")
+	bool bMovableZone = false;
+
+	/*Keep curved spline points instead of forcing every point to Linear
+	 *The curve is tessellated once on construction, so queries still only test straight edges*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config")
+	bool bPreserveCurves = false;
+
+	/*Maximum distance (cm) the tessellated polygon is allowed to deviate from the curved spline*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config", meta=(EditCondition="bPreserveCurves", ClampMin="0.1"))
+	float CurveTolerance = 10.0f;
+
+	/*Upper limit of polygon vertices generated for each curved spline segment
+	 *Segments are halved, so the limit used is the largest 2^n - 1 that fits (1, 3, 7, 15, 31...)*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config", meta=(EditCondition="bPreserveCurves", ClampMin="1", ClampMax="255"))
+	int32 MaxVerticesPerSegment = 15;
+
+	/*Removes polygon vertices that barely change the shape, fewer vertices makes every PolyZone test cheaper
+	 *Outer keeps the whole original shape inside the zone, Inner keeps the zone inside the original shape*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config")
+	POLYZONE_SIMPLIFY_MODE SimplifyMode = POLYZONE_SIMPLIFY_MODE::None;
+
+	/*Maximum distance (cm) the simplified polygon is allowed to deviate from the original polygon*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config", meta=(EditCondition="SimplifyMode != POLYZONE_SIMPLIFY_MODE::None", ClampMin="0.1"))
+	float SimplifyTolerance = 5.0f;
+
+	/*Split concave zones into convex pieces, each piece is tested in O(log N) instead of testing every edge*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config", AdvancedDisplay)
+	bool bDecomposeConcave = false;
+
+	/*Concave zones that need more convex pieces than this keep using the generic polygon test*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config", AdvancedDisplay, meta=(EditCondition="bDecomposeConcave", ClampMin="2"))
+	int32 MaxConvexPieces = 8;
+
+	/*Exact integer point in polygon tests on a 1/16cm fixed point grid, containment results are bit for bit identical on every platform
+	 *Use for server authoritative checks, slower than the convex paths and limited to zones within about 167km of their actor*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config", AdvancedDisplay)
+	bool bRobustPredicates = false;
+
+	/*Count tracked actors per grid cell for heatmaps, crowd density and AI (see the PolyZone|Occupancy functions)
+	 *Counts only change when an actor crosses into another cell. Zones with fewer than 6 vertices have no grid, so no occupancy*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone Config", AdvancedDisplay)
+	bool bOccupancyLayer = false;
+
+	/*Seconds until an old count only weighs half as much in the occupancy history*/
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone Config", AdvancedDisplay, meta=(EditCondition="bOccupancyLayer", ClampMin="0.1"))
+	float OccupancyHalfLife = 10.0f;
+
+	/*Warn when the final polygon has more vertices than this (0 = no budget)*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config", meta=(ClampMin="0"))
+	int32 VertexBudget = 0;
+
+	/*Draw the grid cells in the world, cells holding an actor within the zone are highlighted
+	 *The cells are batched once per rebuild or move, so this is cheap enough to leave on for many zones*/
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone Config", AdvancedDisplay)
 	bool bDebugGrid = false;
 	
@@ -133,52 +365,81 @@ public:
 public:
 	// -- PolyZone Grid --
 
-	/*Origin of the PolyZone grid in world space (Also the location of Grid 0,0)*/
+	/*Origin of the PolyZone grid in world space (Also the location of Grid 0,0)
+	 *The grid itself lives in the zone's local space, so it rotates and scales with the actor*/
 	UPROPERTY(BlueprintReadOnly, Category = "PolyZone|Grid")
 	FVector GridOrigin = FVector::ZeroVector;
 
+	/*World space size of a grid cell*/
 	UPROPERTY(BlueprintReadOnly, Category = "PolyZone|Grid")
+	double CellSize = 50.0;
+
+	/*Flags of every grid cell, Blueprints read them from the shared shape through GetGridData
+	 *Always empty in C++, use GetShape()->GridData instead*/
+	UPROPERTY(Transient, BlueprintReadOnly, BlueprintGetter = GetGridData, Category = "PolyZone|Grid")
 	TArray<POLYZONE_CELL_FLAGS> GridData;
 
-	UPROPERTY(BlueprintReadOnly, Category = "PolyZone|Grid")
-	float CellSize = 50.0f;
+	// -- PolyZone Stats --
+
+	/*Polygon vertices before simplification (spline points plus any tessellated curve points)*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "PolyZone Stats")
+	int32 SourceVertexCount = 0;
+
+	/*Polygon vertices actually used by the PolyZone tests*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "PolyZone Stats")
+	int32 PolygonVertexCount = 0;
+
+	/*Which point in polygon test this zone uses, convex zones are the cheapest to query*/
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "PolyZone Stats")
+	POLYZONE_QUERY_PATH QueryPath = POLYZONE_QUERY_PATH::Polygon;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Transient, Category = "PolyZone Stats")
+	int32 ConvexPieceCount = 0;
 	
 private:
+	friend class UPolyZone_BenchmarkCommandlet; // Times actor tracking directly, without physics overlaps
+	friend struct FPolyZone_MemberItem; // Forwards replicated enters and exits
+	friend class UPolyZone_Subsystem; // Builds streamed in zones from its queue
+
+	void Activate_PolyZone();
+
 	void Build_PolyZone();
-	void Construct_Polygon();
+	void Construct_Polygon(TArray<FVector2D>& OutPolygon);
+	void Construct_TessellateSegment(float StartKey, const FVector& StartPoint, float EndKey, const FVector& EndPoint, int32 Depth, TArray<FVector2D>& OutPolygon);
+	void Construct_Shape(const TArray<FVector2D>& SourcePolygon);
 	void Construct_Bounds();
-	void Construct_SetupGrid();
 	void Construct_Visualizer();
+	void Construct_Occupancy();
+	void Construct_HeightField();
+	double SampleSplineFloor(const FVector2D& LocalPoint, const TArray<FVector>& HeightSamples) const;
+	FPolyZone_EdgePoint MakeEdgePoint(double LocalDistance, float HeightToAdd) const;
+	TArray<FVector> MakeWorldPoints(const TArray<FVector2D>& LocalPoints, bool RandomHeight, FRandomStream& Stream) const;
 	void DoActorTracking();
 	void PolyZoneOverlapChange(AActor* TrackedActor, bool NewIsOverlapped);
-	bool IsPointWithinPolygon(FVector2D TestPoint);
-	static bool IsPointInAABB_2D(const FVector2D& Point, const FVector2D& Min, const FVector2D& Max);
-	static float Cross2D(const FVector2D& A, const FVector2D& B, const FVector2D& C);
-	static bool IsOnSegment2D(const FVector2D& A, const FVector2D& B, const FVector2D& P);
-	static bool SegmentsIntersect2D(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D);
-	POLYZONE_CELL_FLAGS TestCellAgainstPolygon(FPolyZone_GridCell Cell);
 	void DrawDebugGrid();
-	int32 GetGridCellIndex(const FPolyZone_GridCell& Cell) const;
+	void Build_DebugGrid();
+	void UpdateZoneFrame();
+	void OnZoneTransformUpdated(USceneComponent* UpdatedComponent, EUpdateTransformFlags UpdateTransformFlags, ETeleportType Teleport);
+	void OnReplicatedMemberChange(AActor* Member, bool NewIsOverlapped);
+	void InvalidateQuerySnapshot();
+	void RefreshActorsInPolyZone();
+	bool PrepareQueryCache();
+	bool FindCachedQuery(const FVector& Location, bool SkipHeight, bool& OutResult);
+	void AddCachedQuery(const FVector& Location, bool SkipHeight, bool Result);
 	
 	bool WantsDestroyed = false; // A blueprint called destroy on us
-	
-	// -- Bounds --
-	FBoxSphereBounds PolyBounds = FBoxSphereBounds();
-	double Bounds_MinX = 0.0;
-	double Bounds_MaxX = 0.0;
-	double Bounds_MinY = 0.0;
-	double Bounds_MaxY = 0.0;
+	bool bBuildQueued = false; // Waiting in the subsystem's build queue, cleared if we end play first
 
-	// -- Grid --
-	bool UsesGrid = false;
-	int32 GridCellsX = 0;
-	int32 GridCellsY = 0;
-
-	TArray<FVector2D> CornerDirections; // Multipliers to get each corner of a cell
-
-	// -- Polygon --
-	TArray<FVector> Polygon;
-	TArray<FVector2D> Polygon2D;
+	// Cells of the last editor build, saved with the level so loading skips the cell tests
+	UPROPERTY()
+	FPolyZone_BakedGrid BakedGrid;
+	
+	// -- Shape (polygon and grid in local space) --
+	FPolyZone_ShapePtr Shape;
+	FPolyZone_Frame ZoneFrame;
+	FPolyZone_HeightFieldPtr HeightField; // Only when HeightMode isn't Flat
+	FPolyZone_QuerySnapshotPtr QuerySnapshot; // Made on demand by GetQuerySnapshot
+	TSharedRef<std::atomic<uint32>, ESPMode::ThreadSafe> QueryVersion = MakeShared<std::atomic<uint32>, ESPMode::ThreadSafe>(0u);
 
 	// -- Actor Tracking (Actors within box bounds) --
 	UPROPERTY()
@@ -187,6 +448,33 @@ private:
 	UPROPERTY()
 	TArray<AActor*> ActorsInPolyZone; // All tracked actors currently within the PolyZone
 
+	UPROPERTY(Replicated)
+	FPolyZone_MemberArray ReplicatedMembers; // Server side copy of ActorsInPolyZone, only used with bReplicateMembership
+
+	FPolyZone_Occupancy Occupancy; // Only sized while playing with bOccupancyLayer
+
+	// Scratch for the grid searches, kept so repeated searches don't allocate
+	FPolyZone_GridSearch GridSearch;
+	TArray<int32> GridSearchCells;
+
+	// Cached grid lines, persistent until the zone is rebuilt or moved
+	UPROPERTY(Transient)
+	ULineBatchComponent* DebugGridLines = nullptr;
+	bool DebugGridDirty = true;
+
+	// Reused every tracking update, so the batch query doesn't allocate
+	TArray<FVector2D> TrackingPoints;
+	TArray<double> TrackingHeights; // Only with a height field, flat zones leave the height to the overlap box
+	TArray<bool> TrackingResults;
+	uint64 TrackingFrame = 0; // GFrameCounter of the last DoActorTracking
+
+	// -- Query cache (bCacheQueries) --
+	TMap<FVector, uint8> QueryCache; // Exact world location to known results, see the flags in PolyZone.cpp
+	uint64 QueryCacheFrame = 0;
+	float QueryCacheZoneHeight = 0.0f; // ZoneHeight can be written directly from C++, a change drops the cached height results
+	uint32 QueryCacheHits = 0;
+	uint32 QueryCacheMisses = 0;
+
 	UFUNCTION()
 	void OnBeginBoundsOverlap(UPrimitiveComponent* OverlappedComp, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
 	UFUNCTION()
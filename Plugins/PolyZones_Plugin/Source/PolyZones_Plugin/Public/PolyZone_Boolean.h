@@ -0,0 +1,44 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "PolyZone_Boolean.generated.h"
+
+class APolyZone;
+
+UENUM(BlueprintType)
+enum class POLYZONE_BOOLEAN_OP : uint8
+{
+	Union, // Inside any of the zones
+	Intersection, // Inside every zone
+	Difference // Inside the first zone and none of the others
+};
+
+/*Boolean operations on polygons in a shared 2D space
+ *Edges are split where the polygons meet, kept or dropped depending on which side of the other polygon they are, then stitched back into rings
+ *Vertices are snapped to the fixed point grid (1/16 cm), so touching and overlapping edges match exactly. Keep coordinates within FixedPointMaxCoord (~167 km) of the origin*/
+class POLYZONES_PLUGIN_API FPolyZone_Boolean
+{
+public:
+	/*Rings of A op B, outer rings are counter-clockwise and holes clockwise
+	 *A single input ring may have either winding, inputs with more rings must follow the output convention. Rings must not self intersect*/
+	static void Compute(const TArray<TArray<FVector2D>>& A, const TArray<TArray<FVector2D>>& B, POLYZONE_BOOLEAN_OP Operation, TArray<TArray<FVector2D>>& OutRings);
+
+	// One outline per outer ring, holes are joined to the outer ring that contains them with a keyhole cut so a zone spline can follow them
+	static void MakeOutlines(const TArray<TArray<FVector2D>>& Rings, TArray<TArray<FVector2D>>& OutOutlines);
+};
+
+UCLASS()
+class POLYZONES_PLUGIN_API UPolyZone_BooleanLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/*Spawns zones covering the union, intersection or difference (first zone minus the others) of the zones
+	 *One zone per separate area, each with its own grid, so the composite region costs a single query. Rotation and scale are baked into the outline
+	 *Union spans the lowest to the highest zone, intersection only the height every zone shares, difference keeps the first zone's height*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Boolean", meta=(WorldContext="WorldContextObject"))
+	static TArray<APolyZone*> CombinePolyZones(const UObject* WorldContextObject, const TArray<APolyZone*>& Zones, POLYZONE_BOOLEAN_OP Operation, TSubclassOf<APolyZone> ZoneClass);
+};
@@ -0,0 +1,85 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PolyZone_Geometry.generated.h"
+
+UENUM(BlueprintType)
+enum class POLYZONE_SIMPLIFY_MODE : uint8
+{
+	None, // Keep every vertex
+	Standard, // Remove any vertex within tolerance, the shape may shrink or grow slightly
+	Outer, // Only remove vertices that grow the shape, the result always contains the original polygon
+	Inner // Only remove vertices that shrink the shape, the result always fits inside the original polygon
+};
+
+UENUM(BlueprintType)
+enum class POLYZONE_QUERY_PATH : uint8
+{
+	Polygon, // Generic point in polygon test, every edge is checked
+	Convex, // The polygon is convex, a binary search over its wedges finds the only edge that matters
+	ConvexPieces, // Concave polygon split into a few convex pieces, each with their own bounds
+	FixedPoint // Robust predicates, exact integer tests on a fixed point copy of the polygon
+};
+
+struct FPolyZone_ConvexPiece
+{
+	TArray<FVector2D> Points; // Counter-clockwise
+	FVector2D Min = FVector2D::ZeroVector;
+	FVector2D Max = FVector2D::ZeroVector;
+};
+
+// Local space point snapped to the fixed point grid used by the robust predicates
+struct FPolyZone_FixedPoint
+{
+	int64 X = 0;
+	int64 Y = 0;
+
+	bool operator==(const FPolyZone_FixedPoint& Other) const { return X == Other.X && Y == Other.Y; }
+
+	friend uint32 GetTypeHash(const FPolyZone_FixedPoint& Point) { return HashCombine(GetTypeHash(Point.X), GetTypeHash(Point.Y)); }
+};
+
+// Polygon helpers used while constructing PolyZones, all polygons are closed loops (last point connects to the first)
+struct POLYZONES_PLUGIN_API FPolyZone_Geometry
+{
+	// Positive for counter-clockwise polygons
+	static double SignedArea(const TArray<FVector2D>& Polygon);
+
+	static bool IsPointInAABB_2D(const FVector2D& Point, const FVector2D& Min, const FVector2D& Max);
+	static double Cross2D(const FVector2D& A, const FVector2D& B, const FVector2D& C);
+	static bool IsOnSegment2D(const FVector2D& A, const FVector2D& B, const FVector2D& P);
+	static bool SegmentsIntersect2D(const FVector2D& A, const FVector2D& B, const FVector2D& C, const FVector2D& D);
+
+	/*Removes vertices (smallest area first) as long as no original vertex strays further than Tolerance from the result
+	 *Vertices are never removed if it would make the polygon self intersect, returns the number of removed vertices*/
+	static int32 SimplifyPolygon(TArray<FVector2D>& Polygon, POLYZONE_SIMPLIFY_MODE Mode, double Tolerance);
+
+	// True if every turn of the polygon goes the same way (collinear points are allowed)
+	static bool IsConvex(const TArray<FVector2D>& Polygon);
+
+	// O(log N) test for a counter-clockwise convex polygon, points on the edge count as inside
+	static bool IsPointInConvexPolygon(const TArray<FVector2D>& Polygon, const FVector2D& Point);
+
+	/*Splits a simple polygon into convex pieces (ear clipping, then merging triangles while they stay convex)
+	 *Returns false if the polygon could not be triangulated, for example if it self intersects*/
+	static bool DecomposeConvex(const TArray<FVector2D>& Polygon, TArray<FPolyZone_ConvexPiece>& OutPieces);
+
+	// -- Fixed point (robust) predicates --
+	// Every test below is exact integer math, so results are identical on every platform and compiler
+
+	static constexpr double FixedPointScale = 16.0; // Fixed point units per cm
+	static constexpr int64 FixedPointMaxCoord = int64(1) << 28; // Products of coordinate differences stay well inside int64 up to here (about 167km)
+
+	// Out of range points are clamped, they will still fail any bounds check
+	static FPolyZone_FixedPoint ToFixedPoint(const FVector2D& Point);
+	static FVector2D FromFixedPoint(const FPolyZone_FixedPoint& Point);
+
+	// Exact turn direction of A -> B -> C, > 0 turns left, 0 is collinear
+	static int64 Orientation_Fixed(const FPolyZone_FixedPoint& A, const FPolyZone_FixedPoint& B, const FPolyZone_FixedPoint& C);
+	static bool SegmentsIntersect_Fixed(const FPolyZone_FixedPoint& A, const FPolyZone_FixedPoint& B, const FPolyZone_FixedPoint& C, const FPolyZone_FixedPoint& D);
+
+	// Exact crossing test, points on the edge count as inside
+	static bool IsPointInPolygon_Fixed(const TArray<FPolyZone_FixedPoint>& Polygon, const FPolyZone_FixedPoint& Point);
+};
@@ -58,3 +58,39 @@ enum class POLYZONE_CELL_FLAGS : uint8
 {
 	Outside, Within, OnEdge // Outside is the default because cells outside the grid return the default
 };
+
+// Grid cells saved with a placed zone, so loading it doesn't have to test every cell against the polygon again
+USTRUCT()
+struct FPolyZone_BakedGrid
+{
+	GENERATED_BODY()
+
+	// FPolyZone_Shape::GetSourceHash of the polygon the cells were tested against, the cells are ignored once it changes
+	UPROPERTY()
+	uint32 SourceHash = 0;
+
+	UPROPERTY()
+	TArray<POLYZONE_CELL_FLAGS> GridData;
+
+	// Checked along with the hash, a 32 bit hash alone can collide between polygons
+	UPROPERTY()
+	int32 NumVertices = 0;
+
+	UPROPERTY()
+	FBox2D SourceBounds = FBox2D(ForceInit);
+
+	void Bake(uint32 InSourceHash, TConstArrayView<FVector2D> SourcePolygon, const TArray<POLYZONE_CELL_FLAGS>& InGridData)
+	{
+		SourceHash = InSourceHash;
+		GridData = InGridData;
+		NumVertices = SourcePolygon.Num();
+		SourceBounds = FBox2D(SourcePolygon.GetData(), SourcePolygon.Num());
+	}
+
+	// The baked cells if they were tested against this polygon, empty otherwise
+	TConstArrayView<POLYZONE_CELL_FLAGS> Find(uint32 InSourceHash, TConstArrayView<FVector2D> SourcePolygon) const
+	{
+		const bool Matches = SourceHash == InSourceHash && NumVertices == SourcePolygon.Num() && SourceBounds == FBox2D(SourcePolygon.GetData(), SourcePolygon.Num());
+		return Matches ? TConstArrayView<POLYZONE_CELL_FLAGS>(GridData) : TConstArrayView<POLYZONE_CELL_FLAGS>();
+	}
+};
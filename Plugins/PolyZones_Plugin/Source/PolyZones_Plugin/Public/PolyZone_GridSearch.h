@@ -0,0 +1,47 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FPolyZone_Shape;
+
+/*Flood fill, BFS and A* over the grid cells of a shape, cells are addressed by index (X + Y * GridCellsX)
+ *Walkable cells are Within, plus OnEdge when AllowEdgeCells is set. Moves are 4-way, A* also moves diagonally without cutting corners
+ *The scratch buffers are kept between queries and only grow, so searches don't allocate once warmed up (outputs are reused too)
+ *Not thread safe, give every thread its own instance*/
+class POLYZONES_PLUGIN_API FPolyZone_GridSearch
+{
+public:
+	// Every walkable cell connected to Start, in BFS order. Returns false if Start isn't walkable
+	bool FloodFill(const FPolyZone_Shape& Shape, int32 StartIndex, bool AllowEdgeCells, TArray<int32>& OutCells, int32 MaxCells = MAX_int32);
+
+	// Fewest 4-way steps from Start to Goal, both included in OutPath
+	bool FindPathBFS(const FPolyZone_Shape& Shape, int32 StartIndex, int32 GoalIndex, bool AllowEdgeCells, TArray<int32>& OutPath);
+
+	// Shortest 8-way path from Start to Goal (diagonals cost sqrt 2), both included in OutPath
+	bool FindPathAStar(const FPolyZone_Shape& Shape, int32 StartIndex, int32 GoalIndex, bool AllowEdgeCells, TArray<int32>& OutPath);
+
+	// Walkable cell whose center is closest to a local point (inside or outside the grid), INDEX_NONE if there are none
+	static int32 FindNearestWalkableCell(const FPolyZone_Shape& Shape, const FVector2D& LocalPoint, bool AllowEdgeCells);
+
+	static bool IsWalkable(const FPolyZone_Shape& Shape, int32 CellIndex, bool AllowEdgeCells);
+
+private:
+	void BeginSearch(const FPolyZone_Shape& Shape);
+	bool IsVisited(int32 CellIndex) const { return VisitStamps[CellIndex] == Stamp; }
+	void Visit(int32 CellIndex, int32 ParentIndex, float Cost);
+	void BuildPath(int32 GoalIndex, TArray<int32>& OutPath) const;
+	void OpenCell(int32 CellIndex, float Score); // Adds the cell to the A* heap, or moves it up if it's already there
+	int32 PopCheapestCell();
+
+	// Stamped instead of cleared, a cell is visited when its stamp matches the current search
+	TArray<uint32> VisitStamps;
+	uint32 Stamp = 0;
+	TArray<int32> Parents;
+	TArray<float> Costs;
+	TArray<int32> Queue;
+	TArray<float> Scores; // A* cost so far plus the heuristic
+	TArray<int32> HeapSlots;
+	TArray<int32> OpenHeap;
+};
@@ -0,0 +1,63 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/Interval.h"
+#include "PolyZone_HeightField.generated.h"
+
+class FPolyZone_Shape;
+
+UENUM(BlueprintType)
+enum class POLYZONE_HEIGHT_MODE : uint8
+{
+	Flat, // One slab from the actor up to ZoneHeight
+	SplineHeight, // The floor follows the height of the spline points, blended across the zone
+	TerrainTrace // The floor follows whatever is below each grid cell, traced once on build
+};
+
+/*Floor height range of every grid cell of a zone, relative to the zone's Z (cm)
+ *Baked once on build, a height check is then one cell lookup. The ceiling of a cell is its highest floor plus ZoneHeight,
+ *so ZoneHeight can still change at runtime. Immutable once built and shared with query snapshots*/
+class POLYZONES_PLUGIN_API FPolyZone_HeightField
+{
+public:
+	// Samples the floor at every cell corner and center, SampleFloor takes a local point and returns its floor relative to the zone's Z
+	void Build(const FPolyZone_Shape& Shape, TFunctionRef<double(const FVector2D& LocalPoint)> SampleFloor);
+
+	// Floor range of the cell under a local point, points off the grid use the nearest edge cell
+	FORCEINLINE const FFloatInterval& GetFloorRange(const FVector2D& LocalPoint) const
+	{
+		const int32 GridX = FMath::Clamp(FMath::FloorToInt32((LocalPoint.X - GridOrigin.X) * InvCellSize), 0, CellsX - 1);
+		const int32 GridY = FMath::Clamp(FMath::FloorToInt32((LocalPoint.Y - GridOrigin.Y) * InvCellSize), 0, CellsY - 1);
+		return FloorRanges.GetData()[GridX + GridY * CellsX];
+	}
+
+	// Height check shared by zones and snapshots, a null field is the flat slab from 0 to ZoneHeight
+	static FORCEINLINE bool IsWithinZoneHeight(const FPolyZone_HeightField* HeightField, const FVector2D& LocalPoint, double RelativeZ, double ZoneHeight)
+	{
+		if( !HeightField )
+		{
+			return RelativeZ >= 0.0 && RelativeZ <= ZoneHeight;
+		}
+		const FFloatInterval& FloorRange = HeightField->GetFloorRange(LocalPoint);
+		return RelativeZ >= FloorRange.Min && RelativeZ <= FloorRange.Max + ZoneHeight;
+	}
+
+	bool IsValid() const { return FloorRanges.Num() > 0; }
+
+	// Lowest and highest floor of the whole zone, the overlap box spans these plus ZoneHeight
+	const FFloatInterval& GetTotalRange() const { return TotalRange; }
+
+	SIZE_T GetAllocatedSize() const { return FloorRanges.GetAllocatedSize(); }
+
+private:
+	TArray<FFloatInterval> FloorRanges; // Same layout as the shape's GridData
+	FFloatInterval TotalRange = FFloatInterval(0.0f, 0.0f);
+	FVector2D GridOrigin = FVector2D::ZeroVector;
+	double InvCellSize = 0.0;
+	int32 CellsX = 0;
+	int32 CellsY = 0;
+};
+
+typedef TSharedPtr<const FPolyZone_HeightField, ESPMode::ThreadSafe> FPolyZone_HeightFieldPtr;
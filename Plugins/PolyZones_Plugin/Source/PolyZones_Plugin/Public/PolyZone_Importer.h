@@ -0,0 +1,88 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "PolyZone_Shape.h"
+#include "PolyZone_Importer.generated.h"
+
+class APolyZone;
+class UPolyZone_ZoneSet;
+
+// How imported coordinates are turned into world locations
+USTRUCT(BlueprintType)
+struct FPolyZone_ImportSettings
+{
+	GENERATED_BODY()
+
+	/*Multiplies every coordinate, 100 turns meters into centimeters*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone|Import")
+	float Scale = 100.0f;
+
+	/*Coordinates are longitude and latitude in degrees, projected to meters around the first point (equirectangular, fine for a few tens of km)*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone|Import")
+	bool bGeographic = false;
+
+	/*GIS data has north on +Y, flipping Y keeps the map from being mirrored in Unreal's left handed space*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone|Import")
+	bool bFlipY = true;
+
+	/*Added to every point after scaling (cm), Z is the height every zone starts at*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone|Import")
+	FVector Offset = FVector::ZeroVector;
+
+	/*ZoneHeight of zones without a "height" property or column*/
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "PolyZone|Import")
+	float DefaultHeight = 250.0f;
+};
+
+// One polygon read from a file, BuildZones fills in the origin, local polygon and shape
+struct FPolyZone_ImportedZone
+{
+	FName Name;
+	TArray<FVector2D> WorldPolygon;
+	float Height = 0.0f;
+
+	FVector Origin = FVector::ZeroVector; // Center of the polygon bounds, the zone actor goes here
+	TArray<FVector2D> LocalPolygon;
+	FPolyZone_ShapePtr Shape; // Keeps the shape cached, so zones spawned from this import don't build it again
+};
+
+/*Reads zones from GeoJSON (Polygon and MultiPolygon features, outer rings only) or CSV (one "name,x,y[,height]" row per vertex)
+ *Shapes are built on worker threads, the result can be spawned as APolyZone actors or stored as one UPolyZone_ZoneSet asset*/
+class POLYZONES_PLUGIN_API FPolyZone_Importer
+{
+public:
+	// Picks the parser from the file extension (.geojson, .json or .csv)
+	static bool ParseFile(const FString& FilePath, const FPolyZone_ImportSettings& Settings, TArray<FPolyZone_ImportedZone>& OutZones, FString& OutError);
+	static bool ParseGeoJson(const FString& Text, const FPolyZone_ImportSettings& Settings, TArray<FPolyZone_ImportedZone>& OutZones, FString& OutError);
+	static bool ParseCsv(const FString& Text, const FPolyZone_ImportSettings& Settings, TArray<FPolyZone_ImportedZone>& OutZones, FString& OutError);
+
+	// Local polygons and shapes of every zone, in parallel. Use the settings of the zone class the zones will be spawned as, so the shapes are shared
+	static void BuildZones(TArray<FPolyZone_ImportedZone>& Zones, const FPolyZone_ShapeSettings& ShapeSettings);
+
+	static UPolyZone_ZoneSet* CreateZoneSet(const TArray<FPolyZone_ImportedZone>& Zones, UObject* Outer, FName Name = NAME_None, EObjectFlags Flags = RF_NoFlags);
+	static TArray<APolyZone*> SpawnZones(UWorld* World, const TArray<FPolyZone_ImportedZone>& Zones, TSubclassOf<APolyZone> ZoneClass);
+
+	// Spawns a zone whose spline follows the local polygon, construction finds the shape in the cache when it was built beforehand
+	static APolyZone* SpawnZone(UWorld* World, TSubclassOf<APolyZone> ZoneClass, FName Name, const FVector& Origin, float Height, const TArray<FVector2D>& LocalPolygon);
+
+private:
+	static void ApplySettings(TArray<FPolyZone_ImportedZone>& Zones, const FPolyZone_ImportSettings& Settings);
+};
+
+UCLASS()
+class POLYZONES_PLUGIN_API UPolyZone_ImportLibrary : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/*Imports a GeoJSON or CSV file into a new zone set (transient, save it from the editor or use the PolyZone_Import commandlet)*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Import")
+	static UPolyZone_ZoneSet* ImportZoneSet(const FString& FilePath, const FPolyZone_ImportSettings& Settings);
+
+	/*Imports a GeoJSON or CSV file and spawns one zone actor per polygon*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Import", meta=(WorldContext="WorldContextObject"))
+	static TArray<APolyZone*> SpawnZonesFromFile(const UObject* WorldContextObject, const FString& FilePath, TSubclassOf<APolyZone> ZoneClass, const FPolyZone_ImportSettings& Settings);
+};
@@ -0,0 +1,51 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+class UTexture2D;
+
+/*How many tracked actors are in each grid cell of a zone, and a decaying average of that count over time
+ *Only the cells an actor leaves or enters are touched, the history of every other cell is brought up to date when it is read*/
+struct POLYZONES_PLUGIN_API FPolyZone_Occupancy
+{
+	// Clears every count and sizes the layer to a grid, HalfLife (seconds) is how quickly the history forgets
+	void Reset(int32 InCellsX, int32 InCellsY, double InHalfLife);
+	void Empty();
+	bool IsValid() const { return Cells.Num() > 0; }
+
+	// Moves an actor to a cell, INDEX_NONE takes it out of the layer
+	void SetActorCell(const AActor* Actor, int32 CellIndex, double Time);
+
+	int32 GetCount(int32 CellIndex) const;
+	float GetHistory(int32 CellIndex, double Time) const;
+	int32 GetNumActors() const { return ActorCells.Num(); }
+
+	// Cell indices with the highest count (or history), most occupied first, empty cells are skipped
+	void GetDensestCells(int32 MaxCells, bool UseHistory, double Time, TArray<int32>& OutCellIndices) const;
+
+	// One row per cell: X,Y,Count,History
+	FString ToCsv(double Time) const;
+
+	// One pixel per cell in a PF_R32_FLOAT texture, values are the raw counts (or history), so scale them in the material
+	UTexture2D* CreateTexture(bool UseHistory, double Time) const;
+
+private:
+	struct FCell
+	{
+		int32 Count = 0;
+		float History = 0.0f;
+		double LastTime = 0.0; // When History was last brought up to date
+	};
+
+	void AddToCell(int32 CellIndex, int32 Delta, double Time);
+	float GetHistoryAt(const FCell& Cell, double Time) const;
+
+	TArray<FCell> Cells;
+	TMap<TObjectKey<AActor>, int32> ActorCells;
+	int32 CellsX = 0;
+	int32 CellsY = 0;
+	double DecayRate = 0.0; // ln(2) / HalfLife
+};
@@ -0,0 +1,47 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PolyZone_Shape.h"
+#include "PolyZone_HeightField.h"
+#include <atomic>
+
+/*Frozen copy of everything a PolyZone query needs (shared shape, height field, zone transform and height), safe to hold and query from any thread
+ *Get one on the game thread with APolyZone::GetQuerySnapshot and hand it to async tasks. Rebuilding or moving the zone never changes
+ *a snapshot, it makes it stale instead, so check IsStale() and fetch a new one on the game thread when it matters*/
+class POLYZONES_PLUGIN_API FPolyZone_QuerySnapshot
+{
+public:
+	FPolyZone_QuerySnapshot(const TSharedRef<const FPolyZone_Shape, ESPMode::ThreadSafe>& InShape, const FPolyZone_HeightFieldPtr& InHeightField,
+		const FPolyZone_Frame& InFrame, double InZoneHeight, const TSharedRef<std::atomic<uint32>, ESPMode::ThreadSafe>& InLatestVersion);
+
+	// Same results as the APolyZone functions of the same name, at the time the snapshot was taken
+	bool IsPointWithinPolyZone(const FVector& TestPoint, bool SkipHeight = false) const;
+	void ArePointsWithinPolyZone(TConstArrayView<FVector> TestPoints, TArrayView<bool> OutResults, bool SkipHeight = false) const;
+	POLYZONE_CELL_FLAGS GetFlagAtLocation(const FVector& Location) const;
+	FPolyZone_GridCell GetGridCellAtLocation(const FVector& Location) const;
+	POLYZONE_CELL_FLAGS GetGridCellFlag(const FPolyZone_GridCell& Cell) const;
+
+	const FPolyZone_Shape& GetShape() const { return *Shape; }
+	const FPolyZone_HeightField* GetHeightField() const { return HeightField.Get(); } // Null for Flat zones
+	const FPolyZone_Frame& GetFrame() const { return Frame; }
+	double GetZoneHeight() const { return ZoneHeight; }
+
+	uint32 GetVersion() const { return Version; }
+
+	// True once the zone has been rebuilt, moved or changed height since this snapshot was taken
+	// Height changes count from SetZoneHeight or an editor change, a direct C++ write to ZoneHeight only at the next GetQuerySnapshot
+	bool IsStale() const { return LatestVersion->load(std::memory_order_acquire) != Version; }
+
+private:
+	const TSharedRef<const FPolyZone_Shape, ESPMode::ThreadSafe> Shape;
+	const FPolyZone_HeightFieldPtr HeightField;
+	const FPolyZone_Frame Frame;
+	const double ZoneHeight;
+	const uint32 Version;
+	const TSharedRef<std::atomic<uint32>, ESPMode::ThreadSafe> LatestVersion; // Shared with the zone, so staleness never touches the actor
+};
+
+typedef TSharedRef<const FPolyZone_QuerySnapshot, ESPMode::ThreadSafe> FPolyZone_QuerySnapshotRef;
+typedef TSharedPtr<const FPolyZone_QuerySnapshot, ESPMode::ThreadSafe> FPolyZone_QuerySnapshotPtr;
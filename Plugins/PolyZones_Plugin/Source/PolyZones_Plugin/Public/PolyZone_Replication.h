@@ -0,0 +1,58 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "PolyZone_Replication.generated.h"
+
+class APolyZone;
+
+// One actor the server considers within the zone
+USTRUCT()
+struct FPolyZone_MemberItem : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	AActor* Actor = nullptr;
+
+	// Client side, true once the enter event has fired (the actor reference can arrive after the item)
+	bool bEntered = false;
+
+	void PreReplicatedRemove(const struct FPolyZone_MemberArray& InArraySerializer);
+	void PostReplicatedAdd(const struct FPolyZone_MemberArray& InArraySerializer);
+	void PostReplicatedChange(const struct FPolyZone_MemberArray& InArraySerializer);
+};
+
+/*Server authoritative zone membership
+ *Only enters and exits are sent, so bandwidth scales with transitions instead of with the number of tracked actors*/
+USTRUCT()
+struct FPolyZone_MemberArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FPolyZone_MemberItem> Items;
+
+	UPROPERTY(NotReplicated)
+	APolyZone* Owner = nullptr;
+
+	// Server only
+	void AddMember(AActor* Actor);
+	void RemoveMember(AActor* Actor);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FPolyZone_MemberItem, FPolyZone_MemberArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FPolyZone_MemberArray> : public TStructOpsTypeTraitsBase2<FPolyZone_MemberArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
@@ -0,0 +1,26 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FPolyZone_Shape;
+
+/*Evenly spread point sets inside a shape, in local space. Inside tests go through the shape's grid, so most candidates never reach the polygon
+ *Both run in time linear in the number of points (and cells of the spacing grid), thread safe as long as every thread has its own stream*/
+class POLYZONES_PLUGIN_API FPolyZone_Sampling
+{
+public:
+	/*Blue noise (Bridson's Poisson disk): no two points closer than MinSpacing, and no room left for another one
+	 *MaxPoints 0 fills the whole shape. Once the growth stops, every empty cell of the spacing grid is seeded again (random tries inside the cell),
+	 *so gaps anywhere in a concave shape are filled and only slivers too thin for the tries to hit can stay empty*/
+	static void PoissonDisk(const FPolyZone_Shape& Shape, double MinSpacing, int32 MaxPoints, FRandomStream& Stream, TArray<FVector2D>& OutPoints);
+
+	/*One point per Spacing sized cell of a grid over the shape, moved up to Jitter (0-1) of a cell from the cell center
+	 *Points are at least Spacing * (1 - Jitter) apart, cells whose point lands outside the shape are left empty*/
+	static void Stratified(const FPolyZone_Shape& Shape, double Spacing, float Jitter, FRandomStream& Stream, TArray<FVector2D>& OutPoints);
+
+private:
+	// Coarsens Spacing until the grid over the shape fits MaxSamplingCells, CellsPerSpacing is how many cells span one Spacing along an axis
+	static double ClampSpacing(const FPolyZone_Shape& Shape, double Spacing, double CellsPerSpacing);
+};
@@ -0,0 +1,183 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PolyZone_Grid.h"
+#include "PolyZone_Geometry.h"
+
+// Settings that change how a shape is built, zones only share a shape when these match
+struct FPolyZone_ShapeSettings
+{
+	POLYZONE_SIMPLIFY_MODE SimplifyMode = POLYZONE_SIMPLIFY_MODE::None;
+	double SimplifyTolerance = 0.0;
+	bool bDecomposeConcave = false;
+	int32 MaxConvexPieces = 0;
+	bool bRobustPredicates = false;
+
+	bool operator==(const FPolyZone_ShapeSettings& Other) const
+	{
+		return SimplifyMode == Other.SimplifyMode && SimplifyTolerance == Other.SimplifyTolerance &&
+			bDecomposeConcave == Other.bDecomposeConcave && MaxConvexPieces == Other.MaxConvexPieces && bRobustPredicates == Other.bRobustPredicates;
+	}
+
+	friend uint32 GetTypeHash(const FPolyZone_ShapeSettings& Settings)
+	{
+		uint32 Hash = GetTypeHash(static_cast<uint8>(Settings.SimplifyMode));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.SimplifyTolerance));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.bDecomposeConcave));
+		Hash = HashCombine(Hash, GetTypeHash(Settings.bRobustPredicates));
+		return HashCombine(Hash, GetTypeHash(Settings.MaxConvexPieces));
+	}
+};
+
+// Maps world space into a PolyZone's local space (actor location, yaw and uniform scale)
+struct FPolyZone_Frame
+{
+	FVector Origin = FVector::ZeroVector;
+	FVector2D AxisX = FVector2D(1.0, 0.0); // Local X axis in world XY
+	double Scale = 1.0;
+	double InvScale = 1.0;
+
+	static FPolyZone_Frame FromTransform(const FTransform& Transform);
+
+	FORCEINLINE FVector2D ToLocal(const FVector& WorldLocation) const
+	{
+		const double DeltaX = WorldLocation.X - Origin.X;
+		const double DeltaY = WorldLocation.Y - Origin.Y;
+		return FVector2D((DeltaX * AxisX.X + DeltaY * AxisX.Y) * InvScale, (DeltaY * AxisX.X - DeltaX * AxisX.Y) * InvScale);
+	}
+
+	FORCEINLINE FVector ToWorld(const FVector2D& LocalLocation, double WorldZ) const
+	{
+		const double LocalX = LocalLocation.X * Scale;
+		const double LocalY = LocalLocation.Y * Scale;
+		return FVector(Origin.X + LocalX * AxisX.X - LocalY * AxisX.Y, Origin.Y + LocalX * AxisX.Y + LocalY * AxisX.X, WorldZ);
+	}
+
+	FQuat GetRotation() const;
+};
+
+/*Immutable local space geometry of a PolyZone: the polygon, its query path and the grid
+ *Zones with the same shape and settings share one instance through FindOrBuild, so memory and build cost scale with unique shapes*/
+class POLYZONES_PLUGIN_API FPolyZone_Shape
+{
+public:
+	/*Returns the cached shape for this polygon if one is alive, otherwise builds and caches a new one (thread safe)
+	 *PreviousShape is the shape this zone had before an edit, when the grid layout is unchanged only the cells around the moved vertices are tested again
+	 *BakedGridData is the GridData of an earlier build of the same source polygon (see FPolyZone_BakedGrid::Find), it replaces every cell test when the size matches*/
+	static TSharedRef<const FPolyZone_Shape, ESPMode::ThreadSafe> FindOrBuild(const TArray<FVector2D>& SourcePolygon, const FPolyZone_ShapeSettings& Settings,
+		const FPolyZone_Shape* PreviousShape = nullptr, TConstArrayView<POLYZONE_CELL_FLAGS> BakedGridData = {});
+
+	// Always builds a new shape and never touches the cache (benchmarks and tools)
+	static TSharedRef<const FPolyZone_Shape, ESPMode::ThreadSafe> BuildUncached(const TArray<FVector2D>& SourcePolygon, const FPolyZone_ShapeSettings& Settings,
+		const FPolyZone_Shape* PreviousShape = nullptr, TConstArrayView<POLYZONE_CELL_FLAGS> BakedGridData = {});
+
+	// Identifies a source polygon and its settings, the same hash the cache uses
+	static uint32 GetSourceHash(const TArray<FVector2D>& SourcePolygon, const FPolyZone_ShapeSettings& Settings);
+
+	// Number of unique shapes currently alive in the cache
+	static int32 GetNumCachedShapes();
+
+	~FPolyZone_Shape();
+
+	// -- Queries (all in local space) --
+
+	// Bounds, grid and then polygon test
+	bool IsPointWithinShape(const FVector2D& LocalPoint) const;
+	bool IsPointWithinPolygon(const FVector2D& LocalPoint) const;
+
+	// Batch IsPointWithinShape, every point is run through the grid first and only the OnEdge points go on to the polygon test
+	// OutResults must be as long as LocalPoints
+	void ArePointsWithinShape(TConstArrayView<FVector2D> LocalPoints, TArrayView<bool> OutResults) const;
+
+	// Flag of the cell under a point, points outside the grid are Outside
+	FORCEINLINE POLYZONE_CELL_FLAGS GetCellFlagAtLocal(const FVector2D& LocalPoint) const
+	{
+		if( QueryPath == POLYZONE_QUERY_PATH::FixedPoint )
+		{
+			return GetCellFlagAtFixed(FPolyZone_Geometry::ToFixedPoint(LocalPoint)); // Same cell boundaries the grid was built with
+		}
+
+		const int32 GridX = FMath::FloorToInt32((LocalPoint.X - GridOrigin.X) * InvCellSize);
+		const int32 GridY = FMath::FloorToInt32((LocalPoint.Y - GridOrigin.Y) * InvCellSize);
+
+		// Negative cells wrap to huge unsigned values, so one compare per axis covers both ends of the grid
+		if( static_cast<uint32>(GridX) >= static_cast<uint32>(GridCellsX) || static_cast<uint32>(GridY) >= static_cast<uint32>(GridCellsY) )
+		{
+			return POLYZONE_CELL_FLAGS::Outside;
+		}
+		return GridData.GetData()[GridX + GridY * GridCellsX];
+	}
+
+	// Batch GetCellFlagAtLocal, also applies the bounds check so any point is safe to pass in
+	// OutFlags must be as long as LocalPoints
+	void GetCellFlagsAtLocal(TConstArrayView<FVector2D> LocalPoints, TArrayView<POLYZONE_CELL_FLAGS> OutFlags) const;
+
+	// Integer cell lookup for the robust predicates
+	POLYZONE_CELL_FLAGS GetCellFlagAtFixed(const FPolyZone_FixedPoint& FixedPoint) const;
+
+	FPolyZone_GridCell GetGridCellAtLocation(const FVector2D& LocalPoint) const;
+	int32 GetGridCellIndex(const FPolyZone_GridCell& Cell) const;
+	POLYZONE_CELL_FLAGS GetGridCellFlag(const FPolyZone_GridCell& Cell) const;
+	FVector2D GetGridCellLocal(const FPolyZone_GridCell& Cell) const; // Bottom left corner of the cell
+	TArray<FPolyZone_GridCell> GetAllGridCells() const;
+
+	// Outline length, GetPointAlongEdges wraps distances into [0, GetPerimeter())
+	double GetPerimeter() const { return EdgeDistances.Num() > 0 ? EdgeDistances.Last() : 0.0; }
+
+	// Point on the outline at a distance from vertex 0 (binary search of EdgeDistances), with the outward unit normal of its edge
+	// The edge runs from Polygon[OutEdgeIndex] to the next vertex
+	FVector2D GetPointAlongEdges(double Distance, int32& OutEdgeIndex, FVector2D& OutNormal) const;
+
+	// Island of 4-way connected Within cells the cell belongs to, INDEX_NONE for cells that aren't Within
+	int32 GetCellComponent(int32 CellIndex) const { return CellComponents.IsValidIndex(CellIndex) ? CellComponents[CellIndex] : INDEX_NONE; }
+
+	SIZE_T GetAllocatedSize() const;
+
+	// -- Polygon --
+	TArray<FVector2D> Polygon;
+	int32 SourceVertexCount = 0; // Before simplification
+	FVector2D BoundsMin = FVector2D::ZeroVector;
+	FVector2D BoundsMax = FVector2D::ZeroVector;
+	TArray<double> EdgeDistances; // Distance along the outline to the start of every edge, one more entry for the full perimeter
+	double OutwardSign = 1.0; // Flips the edge normals of clockwise polygons to the outside
+
+	POLYZONE_QUERY_PATH QueryPath = POLYZONE_QUERY_PATH::Polygon;
+	TArray<FVector2D> ConvexPolygon; // Counter-clockwise copy of Polygon, only when the shape is convex
+	TArray<FPolyZone_ConvexPiece> ConvexPieces;
+
+	// -- Grid --
+	bool UsesGrid = false;
+	FVector2D GridOrigin = FVector2D::ZeroVector; // Bottom left corner of cell 0,0
+	double CellSize = 50.0;
+	double InvCellSize = 0.0; // Lookups multiply instead of divide
+	int32 GridCellsX = 0;
+	int32 GridCellsY = 0;
+	TArray<POLYZONE_CELL_FLAGS> GridData;
+	TArray<int32> CellComponents; // Labels for GetCellComponent, same layout as GridData
+	int32 NumComponents = 0;
+
+	// -- Fixed point (robust predicates only, QueryPath is FixedPoint) --
+	TArray<FPolyZone_FixedPoint> FixedPolygon;
+	FPolyZone_FixedPoint FixedBoundsMin;
+	FPolyZone_FixedPoint FixedBoundsMax;
+	FPolyZone_FixedPoint FixedGridOrigin;
+	int64 FixedCellSize = 0;
+
+private:
+	void Build(const TArray<FVector2D>& SourcePolygon, const FPolyZone_ShapeSettings& Settings, const FPolyZone_Shape* PreviousShape, TConstArrayView<POLYZONE_CELL_FLAGS> BakedGridData);
+	void Build_Edges();
+	void Build_QueryPath(const FPolyZone_ShapeSettings& Settings);
+	bool Build_FixedPoint();
+	void Build_Grid(const FPolyZone_Shape* PreviousShape, TConstArrayView<POLYZONE_CELL_FLAGS> BakedGridData);
+	bool CanReuseGrid(const FPolyZone_Shape& PreviousShape) const;
+	bool GetChangedBounds(const FPolyZone_Shape& PreviousShape, FBox2D& OutChangedBounds) const;
+	void Build_Components();
+	POLYZONE_CELL_FLAGS TestCellAgainstPolygon(const FPolyZone_GridCell& Cell) const;
+	POLYZONE_CELL_FLAGS TestCellAgainstPolygon_Fixed(const FPolyZone_GridCell& Cell) const;
+	bool IsPointWithinShape_Fixed(const FPolyZone_FixedPoint& FixedPoint) const;
+	bool IsPointWithinPolygon_PNPoly(const FVector2D& TestPoint) const;
+};
+
+typedef TSharedPtr<const FPolyZone_Shape, ESPMode::ThreadSafe> FPolyZone_ShapePtr;
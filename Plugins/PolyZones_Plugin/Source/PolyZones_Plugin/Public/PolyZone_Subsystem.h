@@ -0,0 +1,167 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "PolyZone_Subsystem.generated.h"
+
+class APolyZone;
+
+// A zone and how far a location is from it, distances are in the XY plane and 0 inside the zone
+USTRUCT(BlueprintType)
+struct FPolyZone_ZoneDistance
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "PolyZone")
+	APolyZone* Zone = nullptr;
+
+	UPROPERTY(BlueprintReadOnly, Category = "PolyZone")
+	float Distance = 0.0f;
+
+	/*Closest point of the zone polygon, at the height of the zone*/
+	UPROPERTY(BlueprintReadOnly, Category = "PolyZone")
+	FVector ClosestPoint = FVector::ZeroVector;
+};
+
+/*Every playing PolyZone in a world, which zones neighbour each other and which zones each tracked actor is in
+ *Neighbours are worked out once when a zone registers, so the relevancy checks are a few bit lookups instead of a distance sweep
+ *Registering and unregistering only touch the zones nearby, and zones streamed in while playing are built a few per frame
+ *within "PolyZones.BuildBudgetMs", so loading a streaming cell full of zones doesn't spike
+ *
+ *Zone based net relevancy, from an actor's IsNetRelevantFor override (only tracked actors, the ones with the PolyZone interface, have zones):
+ *	if( const UPolyZone_Subsystem* ZoneSubsystem = UPolyZone_Subsystem::Get(this) )
+ *	{
+ *		const TOptional<bool> ZoneRelevant = ZoneSubsystem->IsNetRelevantByZone(this, RealViewer, ViewTarget);
+ *		if( ZoneRelevant.IsSet() ) return ZoneRelevant.GetValue(); // Only ever false
+ *	}
+ *	return Super::IsNetRelevantFor(RealViewer, ViewTarget, SrcLocation);*/
+UCLASS()
+class POLYZONES_PLUGIN_API UPolyZone_Subsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	static UPolyZone_Subsystem* Get(const UObject* WorldContextObject);
+
+	virtual void Deinitialize() override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	/*Zones waiting to be built, they act as empty zones until then*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Zones")
+	int32 GetNumQueuedBuilds() const { return BuildQueue.Num() - BuildQueueHead; }
+
+	// -- Zones --
+
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Zones")
+	TArray<APolyZone*> GetAllZones() const;
+
+	/*Zones that contain the location, only zones whose bounds cover the location are tested*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Zones")
+	TArray<APolyZone*> GetZonesAtLocation(FVector Location, bool SkipHeight = false) const;
+
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Zones")
+	TArray<APolyZone*> GetNeighbourZones(APolyZone* Zone) const;
+
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Zones")
+	bool AreZonesNeighbours(APolyZone* ZoneA, APolyZone* ZoneB) const;
+
+	// -- Nearest zones (bounding volume tree over the zone bounds, exact polygon distance on the zones it can't rule out) --
+
+	/*Closest zone to a location, false if there is none within MaxDistance (0 = no limit)*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Zones")
+	bool FindNearestZone(FVector Location, FPolyZone_ZoneDistance& Nearest, float MaxDistance = 0.0f);
+
+	/*Up to Count zones closest to a location, nearest first*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Zones")
+	TArray<FPolyZone_ZoneDistance> FindNearestZones(FVector Location, int32 Count = 3, float MaxDistance = 0.0f);
+
+	/*FindNearestZone for many locations, Zone is null where nothing was found
+	 *Each search starts from the previous answer, so nearby locations in a row are cheapest*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Zones")
+	TArray<FPolyZone_ZoneDistance> FindNearestZoneBatch(const TArray<FVector>& Locations, float MaxDistance = 0.0f);
+
+	/*Recomputes the bounds and neighbours of a zone
+	 *Zones call this themselves when they move or rebuild while playing*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Zones")
+	void RefreshZone(APolyZone* Zone);
+
+	// -- Membership (kept up to date by the enter and exit events of every zone) --
+
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Zones")
+	TArray<APolyZone*> GetZonesOfActor(AActor* Actor) const;
+
+	/*True when both actors are in the same zone, or in neighbouring zones when IncludeNeighbours is set*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|Relevancy")
+	bool AreActorsInRelatedZones(AActor* ActorA, AActor* ActorB, bool IncludeNeighbours = true) const;
+
+	/*Zone relevancy for AActor::IsNetRelevantFor, the view target is checked first and then the viewer
+	 *False when the two are in unrelated zones, unset otherwise so the engine's rules decide. Always unset for owners, instigators,
+	 *the view target itself and actors that are always relevant or use owner relevancy, so zones only narrow what Super returns*/
+	TOptional<bool> IsNetRelevantByZone(const AActor* Actor, const AActor* RealViewer, const AActor* ViewTarget) const;
+
+private:
+	friend class APolyZone; // Zones register themselves and report their enters and exits
+
+	void RegisterZone(APolyZone* Zone);
+	void UnregisterZone(APolyZone* Zone);
+	void OnMembershipChange(AActor* Actor, APolyZone* Zone, bool NewIsOverlapped);
+
+	// Zones in streamed levels that begin play mid game are built from the queue, zones that start with the world or are spawned build right away
+	bool ShouldDeferBuild(const APolyZone* Zone) const;
+	void QueueBuild(APolyZone* Zone);
+
+	void AddToBoundsGrid(int32 Slot);
+	void RemoveFromBoundsGrid(int32 Slot);
+	void ComputeNeighbours(int32 Slot);
+	bool AreSlotsRelated(TConstArrayView<int32> SlotsA, TConstArrayView<int32> SlotsB, bool IncludeNeighbours) const;
+
+	void BuildTree();
+	int32 BuildTreeNode(TArrayView<int32> Slots);
+	double GetZoneDistance(int32 Slot, const FVector2D& Point, FVector2D& OutClosest) const;
+	void FindNearestSlots(const FVector2D& Point, int32 Count, double MaxDistance, int32 HintSlot);
+	FPolyZone_ZoneDistance MakeZoneDistance(int32 Slot, const FVector2D& Point) const;
+
+	static constexpr double BoundsGridSize = 5000.0; // World size of a bounds grid bucket (cm)
+	static constexpr int32 MaxBucketsPerZone = 1024; // Bigger zones go in OversizedSlots instead
+
+	struct FZoneEntry
+	{
+		TWeakObjectPtr<APolyZone> Zone;
+		TArray<FVector2D> WorldPolygon;
+		FBox2D Bounds = FBox2D(ForceInit);
+		TBitArray<> Neighbours; // Indexed by slot
+		TArray<TObjectKey<AActor>> Members; // So unregistering only visits this zone's actors
+	};
+
+	TArray<FZoneEntry> Zones; // Slots stay put while a zone is registered, free slots are reused
+	TArray<int32> FreeSlots;
+	TMap<TObjectKey<APolyZone>, int32> ZoneSlots;
+
+	TMultiMap<FIntPoint, int32> BoundsGrid;
+	TArray<int32> OversizedSlots;
+
+	TMap<TObjectKey<AActor>, TArray<int32, TInlineAllocator<4>>> ActorZoneSlots;
+
+	TMultiMap<TObjectKey<APolyZone>, int32> ListedNeighbours; // Zone -> slots that list it in NeighbourZones, it may not be registered yet
+	float MaxNeighbourDistance = 0.0f; // Largest NeighbourDistance registered so far, how far the neighbour search has to look
+
+	TArray<TWeakObjectPtr<APolyZone>> BuildQueue;
+	int32 BuildQueueHead = 0; // Built zones before this index, the queue is reset once it drains
+
+	struct FTreeNode
+	{
+		FBox2D Bounds = FBox2D(ForceInit);
+		int32 Children[2] = { INDEX_NONE, INDEX_NONE };
+		int32 Slot = INDEX_NONE; // Leaves hold one zone
+	};
+	TArray<FTreeNode> TreeNodes; // Root is the first node, rebuilt on the first search after zones change
+	bool bTreeDirty = true;
+
+	// Search scratch, kept between searches
+	TArray<TPair<double, int32>> SearchNodes; // Min heap of (box distance squared, node)
+	TArray<TPair<double, int32>> SearchBest; // Max heap of (distance, slot), the current best Count zones
+};
@@ -0,0 +1,81 @@
+// Copyright 2022-2026 Overtorque Creations LLC. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "PolyZone_Grid.h"
+#include "PolyZone_Shape.h"
+#include "PolyZone_ZoneSet.generated.h"
+
+class APolyZone;
+
+// One zone of a zone set, the polygon is relative to the origin and never rotated or scaled
+USTRUCT(BlueprintType)
+struct FPolyZone_ZoneSetEntry
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone")
+	FName Name;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone")
+	FVector Origin = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone")
+	float Height = 250.0f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone")
+	TArray<FVector2D> Polygon;
+
+	UPROPERTY()
+	FBox2D Bounds = FBox2D(ForceInit); // World XY, so queries can skip most zones without touching their shape
+
+	UPROPERTY()
+	FPolyZone_BakedGrid BakedGrid;
+};
+
+/*Many zones in one asset without an actor each, for large imported data sets
+ *Shapes are built on worker threads the first time the set is queried, spawn actors from it when zones need events or tracking*/
+UCLASS(BlueprintType)
+class POLYZONES_PLUGIN_API UPolyZone_ZoneSet : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	virtual void PostLoad() override;
+	#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+	#endif
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "PolyZone")
+	TArray<FPolyZone_ZoneSetEntry> Zones;
+
+	/*Indices of every zone containing the location*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|ZoneSet")
+	TArray<int32> GetZonesAtLocation(FVector Location, bool SkipHeight = false);
+
+	/*One zone actor per entry, with default shape settings the actors share the shapes of this set*/
+	UFUNCTION(BlueprintCallable, Category = "PolyZone|ZoneSet", meta=(WorldContext="WorldContextObject"))
+	TArray<APolyZone*> SpawnZones(const UObject* WorldContextObject, TSubclassOf<APolyZone> ZoneClass);
+
+	// Builds the shapes that aren't built yet, in parallel (game thread)
+	void BuildShapes();
+
+	FPolyZone_ShapePtr GetShape(int32 Index) const { return Shapes.IsValidIndex(Index) ? Shapes[Index] : nullptr; }
+
+private:
+	// Buckets the zone bounds once, so GetZonesAtLocation only looks at the zones near the location
+	void BuildBoundsGrid();
+
+	// Drops the shapes and bounds grid, the next query builds them from the current entries
+	void ResetCaches();
+
+	static constexpr double BoundsGridSize = 5000.0; // World size of a bounds grid bucket (cm), same as the subsystem
+	static constexpr int32 MaxBucketsPerZone = 1024; // Bigger zones go in OversizedZones instead
+
+	TArray<FPolyZone_ShapePtr> Shapes; // Same order as Zones
+	TMultiMap<FIntPoint, int32> BoundsGrid; // Bucket to zone index
+	TArray<int32> OversizedZones;
+	bool bBoundsGridBuilt = false;
+};
@@ -2,6 +2,166 @@
 
 
 #include "PerformanceTool.h"
+#include "Containers/Ticker.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeLock.h"
+#include <atomic>
+
+DEFINE_LOG_CATEGORY_STATIC(LogPerformanceTool, Log, All);
+
+namespace
+{
+	constexpr uint32 ThreadBufferCapacity = 4096; // Must be a power of two
+	constexpr int32 RollingWindowSize = 1024; // Samples kept per timer for the percentiles
+
+	struct FTimerSample
+	{
+		FName Name;
+		uint64 Cycles = 0;
+	};
+
+	// Ring buffer with a single producer (the owning thread) and a single consumer (the drain, under the registry lock)
+	struct FThreadTimerBuffer
+	{
+		FTimerSample Samples[ThreadBufferCapacity];
+		std::atomic<uint32> WriteIndex{0};
+		std::atomic<uint32> ReadIndex{0};
+		std::atomic<uint32> Dropped{0};
+
+		TArray<TPair<FName, uint64>> OpenTimers; // Only touched by the owning thread
+
+		void Push(FName Name, uint64 Cycles)
+		{
+			const uint32 Write = WriteIndex.load(std::memory_order_relaxed);
+			if( Write - ReadIndex.load(std::memory_order_acquire) >= ThreadBufferCapacity )
+			{
+				Dropped.fetch_add(1, std::memory_order_relaxed); // Full until the next drain
+				return;
+			}
+			FTimerSample& Sample = Samples[Write & (ThreadBufferCapacity - 1)];
+			Sample.Name = Name;
+			Sample.Cycles = Cycles;
+			WriteIndex.store(Write + 1, std::memory_order_release);
+		}
+	};
+
+	struct FTimerAggregate
+	{
+		int64 CallCount = 0;
+		double MinMs = TNumericLimits<double>::Max();
+		double MaxMs = 0.0;
+		double TotalMs = 0.0;
+		TArray<double> Window;
+		int32 WindowNext = 0;
+
+		void Add(double Ms)
+		{
+			CallCount++;
+			MinMs = FMath::Min(MinMs, Ms);
+			MaxMs = FMath::Max(MaxMs, Ms);
+			TotalMs += Ms;
+			if( Window.Num() < RollingWindowSize )
+			{
+				Window.Add(Ms);
+			}
+			else
+			{
+				Window[WindowNext] = Ms;
+				WindowNext = (WindowNext + 1) % RollingWindowSize;
+			}
+		}
+
+		FPerformanceTimerStats MakeStats(FName Name) const
+		{
+			TArray<double> Sorted = Window;
+			Sorted.Sort();
+			auto Percentile = [&Sorted](double Fraction)
+			{
+				return Sorted.Num() > 0 ? Sorted[FMath::Clamp(FMath::CeilToInt(Fraction * Sorted.Num()) - 1, 0, Sorted.Num() - 1)] : 0.0;
+			};
+
+			FPerformanceTimerStats Stats;
+			Stats.Name = Name;
+			Stats.CallCount = CallCount;
+			Stats.MinMs = CallCount > 0 ? MinMs : 0.0;
+			Stats.MaxMs = MaxMs;
+			Stats.MeanMs = CallCount > 0 ? TotalMs / CallCount : 0.0;
+			Stats.P50Ms = Percentile(0.50);
+			Stats.P95Ms = Percentile(0.95);
+			Stats.P99Ms = Percentile(0.99);
+			return Stats;
+		}
+	};
+
+	struct FTimerRegistry
+	{
+		FCriticalSection Lock;
+		TArray<TUniquePtr<FThreadTimerBuffer>> Buffers;
+		TMap<FName, FTimerAggregate> Aggregates;
+		uint64 DroppedSamples = 0;
+
+		static FTimerRegistry& Get()
+		{
+			static FTimerRegistry Registry;
+			return Registry;
+		}
+
+		FTimerRegistry()
+		{
+			// Drain once a frame so the thread buffers don't fill up between dumps
+			FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([this](float DeltaTime)
+			{
+				FScopeLock ScopeLock(&Lock);
+				Drain();
+				return true;
+			}));
+		}
+
+		FThreadTimerBuffer& GetThreadBuffer()
+		{
+			thread_local FThreadTimerBuffer* ThreadBuffer = nullptr;
+			if( !ThreadBuffer )
+			{
+				// Buffers are never freed, a thread that exits leaves its last samples to be drained
+				FScopeLock ScopeLock(&Lock);
+				ThreadBuffer = Buffers.Add_GetRef(MakeUnique<FThreadTimerBuffer>()).Get();
+			}
+			return *ThreadBuffer;
+		}
+
+		// Must be called with the lock held
+		void Drain()
+		{
+			for( const TUniquePtr<FThreadTimerBuffer>& Buffer : Buffers )
+			{
+				uint32 Read = Buffer->ReadIndex.load(std::memory_order_relaxed);
+				const uint32 Write = Buffer->WriteIndex.load(std::memory_order_acquire);
+				for( ; Read != Write; ++Read )
+				{
+					const FTimerSample& Sample = Buffer->Samples[Read & (ThreadBufferCapacity - 1)];
+					Aggregates.FindOrAdd(Sample.Name).Add(FPlatformTime::ToMilliseconds64(Sample.Cycles));
+				}
+				Buffer->ReadIndex.store(Read, std::memory_order_release);
+				DroppedSamples += Buffer->Dropped.exchange(0, std::memory_order_relaxed);
+			}
+		}
+	};
+
+	FAutoConsoleCommand DumpTimersCommand(
+		TEXT("PerformanceTool.DumpTimers"),
+		TEXT("Logs every PerformanceTool timer (calls, min, max, p50, p95, p99). Pass 'csv' to write them to Saved/Profiling/PerformanceTool instead."),
+		FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+		{
+			UPerformanceTool::DumpTimers(Args.Contains(TEXT("csv")));
+		}));
+
+	FAutoConsoleCommand ResetTimersCommand(
+		TEXT("PerformanceTool.ResetTimers"),
+		TEXT("Clears every PerformanceTool timer."),
+		FConsoleCommandDelegate::CreateStatic(&UPerformanceTool::ResetTimers));
+}
 
 double UPerformanceTool::GetCurrentTimeSeconds()
 {
@@ -12,3 +172,115 @@ double UPerformanceTool::MakeElapsedTimeMs(double StartSeconds, double EndSecond
 {
 	return (EndSeconds - StartSeconds)*1000;
 }
+
+void UPerformanceTool::BeginTimer(FName Name)
+{
+	FTimerRegistry::Get().GetThreadBuffer().OpenTimers.Emplace(Name, FPlatformTime::Cycles64());
+}
+
+void UPerformanceTool::EndTimer(FName Name)
+{
+	const uint64 EndCycles = FPlatformTime::Cycles64();
+	FThreadTimerBuffer& Buffer = FTimerRegistry::Get().GetThreadBuffer();
+
+	// Search from the top, so nested and interleaved timers both work
+	for( int32 Index = Buffer.OpenTimers.Num() - 1; Index >= 0; --Index )
+	{
+		if( Buffer.OpenTimers[Index].Key == Name )
+		{
+			Buffer.Push(Name, EndCycles - Buffer.OpenTimers[Index].Value);
+			Buffer.OpenTimers.RemoveAt(Index, 1, false);
+			return;
+		}
+	}
+	UE_LOG(LogPerformanceTool, Warning, TEXT("EndTimer(%s) has no matching BeginTimer on this thread"), *Name.ToString());
+}
+
+void UPerformanceTool::RecordSample(FName Name, uint64 Cycles)
+{
+	FTimerRegistry::Get().GetThreadBuffer().Push(Name, Cycles);
+}
+
+bool UPerformanceTool::GetTimerStats(FName Name, FPerformanceTimerStats& Stats)
+{
+	FTimerRegistry& Registry = FTimerRegistry::Get();
+	FScopeLock ScopeLock(&Registry.Lock);
+	Registry.Drain();
+
+	if( const FTimerAggregate* Aggregate = Registry.Aggregates.Find(Name) )
+	{
+		Stats = Aggregate->MakeStats(Name);
+		return true;
+	}
+	return false;
+}
+
+TArray<FPerformanceTimerStats> UPerformanceTool::GetAllTimerStats()
+{
+	FTimerRegistry& Registry = FTimerRegistry::Get();
+	FScopeLock ScopeLock(&Registry.Lock);
+	Registry.Drain();
+
+	TArray<FPerformanceTimerStats> AllStats;
+	AllStats.Reserve(Registry.Aggregates.Num());
+	for( const TPair<FName, FTimerAggregate>& Pair : Registry.Aggregates )
+	{
+		AllStats.Add(Pair.Value.MakeStats(Pair.Key));
+	}
+	AllStats.Sort([](const FPerformanceTimerStats& A, const FPerformanceTimerStats& B) { return A.Name.LexicalLess(B.Name); });
+	return AllStats;
+}
+
+void UPerformanceTool::DumpTimers(bool ToCsv)
+{
+	const TArray<FPerformanceTimerStats> AllStats = GetAllTimerStats();
+
+	uint64 DroppedSamples = 0;
+	{
+		FTimerRegistry& Registry = FTimerRegistry::Get();
+		FScopeLock ScopeLock(&Registry.Lock);
+		DroppedSamples = Registry.DroppedSamples;
+	}
+
+	if( ToCsv )
+	{
+		FString Csv = TEXT("Name,Calls,MinMs,MaxMs,MeanMs,P50Ms,P95Ms,P99Ms\n");
+		for( const FPerformanceTimerStats& Stats : AllStats )
+		{
+			Csv += FString::Printf(TEXT("%s,%lld,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f\n"), *Stats.Name.ToString(), Stats.CallCount, Stats.MinMs, Stats.MaxMs, Stats.MeanMs,
+				Stats.P50Ms, Stats.P95Ms, Stats.P99Ms);
+		}
+
+		const FString CsvPath = FPaths::ProfilingDir() / TEXT("PerformanceTool") / FString::Printf(TEXT("Timers_%s.csv"), *FDateTime::Now().ToString());
+		if( FFileHelper::SaveStringToFile(Csv, *CsvPath) )
+		{
+			UE_LOG(LogPerformanceTool, Display, TEXT("Wrote %d timers to %s"), AllStats.Num(), *CsvPath);
+		}
+		else
+		{
+			UE_LOG(LogPerformanceTool, Error, TEXT("Could not write timers to %s"), *CsvPath);
+		}
+		return;
+	}
+
+	UE_LOG(LogPerformanceTool, Display, TEXT("%-32s %10s %10s %10s %10s %10s %10s %10s"), TEXT("Timer (ms)"), TEXT("Calls"), TEXT("Min"), TEXT("Max"), TEXT("Mean"),
+		TEXT("P50"), TEXT("P95"), TEXT("P99"));
+	for( const FPerformanceTimerStats& Stats : AllStats )
+	{
+		UE_LOG(LogPerformanceTool, Display, TEXT("%-32s %10lld %10.4f %10.4f %10.4f %10.4f %10.4f %10.4f"), *Stats.Name.ToString(), Stats.CallCount, Stats.MinMs,
+			Stats.MaxMs, Stats.MeanMs, Stats.P50Ms, Stats.P95Ms, Stats.P99Ms);
+	}
+	if( DroppedSamples > 0 )
+	{
+		UE_LOG(LogPerformanceTool, Warning, TEXT("%llu samples were dropped because a thread buffer was full"), DroppedSamples);
+	}
+}
+
+void UPerformanceTool::ResetTimers()
+{
+	FTimerRegistry& Registry = FTimerRegistry::Get();
+	FScopeLock ScopeLock(&Registry.Lock);
+	Registry.Drain();
+	Registry.Aggregates.Reset();
+	Registry.DroppedSamples = 0;
+}
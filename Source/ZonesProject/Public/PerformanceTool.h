@@ -6,8 +6,40 @@
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "PerformanceTool.generated.h"
 
+// Aggregated results of one named timer, percentiles cover the most recent calls
+USTRUCT(BlueprintType)
+struct FPerformanceTimerStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	FName Name;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	int64 CallCount = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	double MinMs = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	double MaxMs = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	double MeanMs = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	double P50Ms = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	double P95Ms = 0.0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Performance")
+	double P99Ms = 0.0;
+};
+
 /**
- * 
+ * Named scoped timers for Blueprint and C++
+ * Samples go into a lock-free buffer per thread and are aggregated once a frame, dump them with "PerformanceTool.DumpTimers [csv]"
  */
 UCLASS()
 class ZONESPROJECT_API UPerformanceTool : public UBlueprintFunctionLibrary
@@ -20,5 +52,47 @@ public:
 
 	UFUNCTION(BlueprintCallable, Category = "Performance")
 	static double MakeElapsedTimeMs(double StartSeconds, double EndSeconds);
-	
+
+	// Starts a named timer on the calling thread, every Begin needs an End with the same name on the same thread
+	UFUNCTION(BlueprintCallable, Category = "Performance|Timers")
+	static void BeginTimer(FName Name);
+
+	UFUNCTION(BlueprintCallable, Category = "Performance|Timers")
+	static void EndTimer(FName Name);
+
+	UFUNCTION(BlueprintCallable, Category = "Performance|Timers")
+	static bool GetTimerStats(FName Name, FPerformanceTimerStats& Stats);
+
+	UFUNCTION(BlueprintCallable, Category = "Performance|Timers")
+	static TArray<FPerformanceTimerStats> GetAllTimerStats();
+
+	// Writes every timer to the log, or to Saved/Profiling/PerformanceTool as CSV
+	UFUNCTION(BlueprintCallable, Category = "Performance|Timers")
+	static void DumpTimers(bool ToCsv);
+
+	UFUNCTION(BlueprintCallable, Category = "Performance|Timers")
+	static void ResetTimers();
+
+	// Adds one finished sample, used by FPerformanceToolScope
+	static void RecordSample(FName Name, uint64 Cycles);
 };
+
+// Times the enclosing C++ scope into the named timer
+struct ZONESPROJECT_API FPerformanceToolScope
+{
+	explicit FPerformanceToolScope(FName InName)
+		: Name(InName), StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FPerformanceToolScope()
+	{
+		UPerformanceTool::RecordSample(Name, FPlatformTime::Cycles64() - StartCycles);
+	}
+
+private:
+	FName Name;
+	uint64 StartCycles;
+};
+
+#define PERFORMANCE_TOOL_SCOPE(Name) FPerformanceToolScope ANONYMOUS_VARIABLE(PerformanceToolScope_)(Name)